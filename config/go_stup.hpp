@@ -201,7 +201,9 @@ public:
     }
 
     void process() {
-        std::default_random_engine generator;
+        // Seed dari id node: tiap worker punya urutan sendiri (bukan tiga salinan urutan yang sama), tetap reproducible
+        std::seed_seq seed(id.begin(), id.end());
+        std::default_random_engine generator(seed);
         std::uniform_int_distribution<int> dist(50, 200);
         
         while (running) {
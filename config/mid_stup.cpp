@@ -9,6 +9,55 @@
 #include <thread>
 #include <fstream>
 #include <sstream>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iomanip>
+#include <bitset>
+#include <unordered_map>
+#include <random>
+#include <array>
+#include <new>
+#include <string_view>
+#include <filesystem>
+#include <exception>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ucontext.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ThreadSanitizer harus diberi tahu setiap pergantian stack fiber
+#if defined(__SANITIZE_THREAD__)
+#define ENGINE_TSAN_FIBERS 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define ENGINE_TSAN_FIBERS 1
+#endif
+#endif
+#if defined(ENGINE_TSAN_FIBERS)
+#include <sanitizer/tsan_interface.h>
+#endif
 
 // =================================================================
 // 1. MATH CORE: LINEAR ALGEBRA ENGINE
@@ -35,6 +84,8 @@ namespace Engine::Math {
             };
         }
 
+        Vector3 hadamard(const Vector3& v) const { return {x * v.x, y * v.y, z * v.z}; }
+
         double length() const { return std::sqrt(x*x + y*y + z*z); }
         
         Vector3 normalize() const {
@@ -43,6 +94,7 @@ namespace Engine::Math {
         }
     };
 
+    // Konvensi vektor kolom: world = parent * local, translasi ada di kolom ke-4
     struct Matrix4x4 {
         double m[4][4] = {0};
         static Matrix4x4 Identity() {
@@ -50,181 +102,7358 @@ namespace Engine::Math {
             for(int i=0; i<4; ++i) mat.m[i][i] = 1.0;
             return mat;
         }
+
+        Matrix4x4 operator*(const Matrix4x4& o) const {
+            Matrix4x4 r;
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    r.m[i][j] = m[i][0] * o.m[0][j] + m[i][1] * o.m[1][j] + m[i][2] * o.m[2][j] + m[i][3] * o.m[3][j];
+                }
+            }
+            return r;
+        }
+
+        // Rotasi Euler (radian) diterapkan X lalu Y lalu Z, kemudian translasi
+        static Matrix4x4 TRS(const Vector3& t, const Vector3& euler, const Vector3& s = Vector3(1, 1, 1)) {
+            const double cx = std::cos(euler.x), sx = std::sin(euler.x);
+            const double cy = std::cos(euler.y), sy = std::sin(euler.y);
+            const double cz = std::cos(euler.z), sz = std::sin(euler.z);
+            Matrix4x4 r;
+            r.m[0][0] = cy * cz * s.x; r.m[0][1] = (sx * sy * cz - cx * sz) * s.y; r.m[0][2] = (cx * sy * cz + sx * sz) * s.z;
+            r.m[1][0] = cy * sz * s.x; r.m[1][1] = (sx * sy * sz + cx * cz) * s.y; r.m[1][2] = (cx * sy * sz - sx * cz) * s.z;
+            r.m[2][0] = -sy * s.x;     r.m[2][1] = sx * cy * s.y;                  r.m[2][2] = cx * cy * s.z;
+            r.m[0][3] = t.x; r.m[1][3] = t.y; r.m[2][3] = t.z; r.m[3][3] = 1.0;
+            return r;
+        }
+
+        Vector3 transformPoint(const Vector3& p) const {
+            return {m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3],
+                    m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3],
+                    m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z + m[2][3]};
+        }
+
+        Vector3 translation() const { return {m[0][3], m[1][3], m[2][3]}; }
     };
 }
 
 // =================================================================
-// 2. SHADER & RENDERING PIPELINE (CRTP Pattern)
+// 2. RANDOM: COUNTER-BASED RNG (Philox4x32-10)
 // =================================================================
 
-template <typename DerivedShader>
-class ShaderBase {
-public:
-    void execute() {
-        static_cast<DerivedShader*>(this)->apply_impl();
+// Philox4x32-10 (Salmon dkk., "Parallel Random Numbers: As Easy as 1, 2, 3"): blok 4x32 bit = f(key, counter)
+// tanpa state bersama, jadi thread mana pun yang menghitung counter yang sama mendapat bit yang sama.
+// Key = (seed, stream), counter = (blok, step, entity.index, entity.generation).
+namespace Random {
+    using Block = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    constexpr uint32_t kPhiloxM0 = 0xD2511F53u, kPhiloxM1 = 0xCD9E8D57u;
+    constexpr uint32_t kPhiloxW0 = 0x9E3779B9u, kPhiloxW1 = 0xBB67AE85u;
+    constexpr int kPhiloxRounds = 10;
+
+    inline Block philox4x32(Block c, Key k) {
+        for (int r = 0; r < kPhiloxRounds; ++r) {
+            const uint64_t p0 = uint64_t(kPhiloxM0) * c[0];
+            const uint64_t p1 = uint64_t(kPhiloxM1) * c[2];
+            c = {uint32_t(p1 >> 32) ^ c[1] ^ k[0], uint32_t(p1), uint32_t(p0 >> 32) ^ c[3] ^ k[1], uint32_t(p0)};
+            k[0] += kPhiloxW0;
+            k[1] += kPhiloxW1;
+        }
+        return c;
     }
-};
 
-class PhongShader : public ShaderBase<PhongShader> {
-public:
-    void apply_impl() {
-        // Simulasi perhitungan pencahayaan Ambient, Diffuse, Specular
-        std::cout << "[Shader] Applying Phong Lighting Model..." << std::endl;
+    // 24 bit teratas -> [0, 1), exact di float
+    inline float toUniform(uint32_t x) { return float(x >> 8) * (1.0f / 16777216.0f); }
+
+    // Normal memakai Box-Muller dengan polinom sendiri (bukan libm) supaya tidak bergantung versi libm dan bisa
+    // divektorkan: elemen ke-i sebuah batch tidak bergantung pada panjang batch. Antar build (scalar / AVX2 / FMA)
+    // normal bisa berbeda ~1 ulp; uniform selalu bit identik.
+    // log(u) untuk u dalam (0, 1], polinom Cephes logf
+    inline float logUnit(float u) {
+        uint32_t bits;
+        std::memcpy(&bits, &u, sizeof(bits));
+        float e = float(int32_t(bits >> 23) - 126);
+        bits = (bits & 0x007FFFFFu) | 0x3F000000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        float x = m - 1.0f;
+        if (m < 0.707106781186547524f) {
+            e = e - 1.0f;
+            x = x + m;
+        }
+        const float z = x * x;
+        float p = 7.0376836292e-2f;
+        p = p * x + -1.1514610310e-1f;
+        p = p * x + 1.1676998740e-1f;
+        p = p * x + -1.2420140846e-1f;
+        p = p * x + 1.4249322787e-1f;
+        p = p * x + -1.6668057665e-1f;
+        p = p * x + 2.0000714765e-1f;
+        p = p * x + -2.4999993993e-1f;
+        p = p * x + 3.3333331174e-1f;
+        float y = p * x * z;
+        y = y + e * -2.12194440e-4f;
+        y = y - z * 0.5f;
+        x = x + y;
+        return x + e * 0.693359375f;
     }
-};
+
+    // sin/cos dari 2*pi*(w >> 8)/2^24: kuadran dipisah di integer (exact), sisa sudut dalam [-pi/4, pi/4]
+    inline void sinCosTurn(uint32_t w, float& s, float& c) {
+        const int32_t t = int32_t(w >> 8);
+        const int32_t q = (t + (1 << 21)) >> 22;
+        const float r = float(t - (q << 22)) * (1.57079632679489662f / 4194304.0f);
+        const float z = r * r;
+        float ps = -1.9515295891e-4f;
+        ps = ps * z + 8.3321608736e-3f;
+        ps = ps * z + -1.6666654611e-1f;
+        ps = ps * z * r + r;
+        float pc = 2.443315711809948e-5f;
+        pc = pc * z + -1.388731625493765e-3f;
+        pc = pc * z + 4.166664568298827e-2f;
+        pc = pc * z * z - z * 0.5f + 1.0f;
+        s = (q & 1) ? pc : ps;
+        c = (q & 1) ? ps : pc;
+        if (q & 2) s = -s;
+        if ((q + 1) & 2) c = -c;
+    }
+
+    inline void boxMuller(uint32_t a, uint32_t b, float& n0, float& n1) {
+        const float u = float((a >> 8) + 1) * (1.0f / 16777216.0f); // (0, 1]
+        const float radius = std::sqrt(logUnit(u) * -2.0f);
+        float s, c;
+        sinCosTurn(b, s, c);
+        n0 = radius * c;
+        n1 = radius * s;
+    }
+
+#if defined(__AVX2__)
+    // 8 blok sekaligus: lane i = counter {c0 + i, c1, c2, c3}. Hasil di-transpose ke urutan blok (4 word per blok),
+    // sama dengan urutan philox4x32 scalar
+    inline __m256i mulHiLo8(__m256i a, __m256i m, __m256i& lo) {
+        const __m256i even = _mm256_mul_epu32(a, m);
+        const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+
+    inline void philox8(const Block& counter, Key key, __m256i r[4]) {
+        __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(int(counter[0])), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256i c1 = _mm256_set1_epi32(int(counter[1]));
+        __m256i c2 = _mm256_set1_epi32(int(counter[2]));
+        __m256i c3 = _mm256_set1_epi32(int(counter[3]));
+        const __m256i m0 = _mm256_set1_epi32(int(kPhiloxM0)), m1 = _mm256_set1_epi32(int(kPhiloxM1));
+        for (int round = 0; round < kPhiloxRounds; ++round) {
+            __m256i lo0, lo1;
+            const __m256i hi0 = mulHiLo8(c0, m0, lo0);
+            const __m256i hi1 = mulHiLo8(c2, m1, lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(key[0])));
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(key[1])));
+            c3 = lo0;
+            key[0] += kPhiloxW0;
+            key[1] += kPhiloxW1;
+        }
+        r[0] = c0; r[1] = c1; r[2] = c2; r[3] = c3;
+    }
+
+    // 4 baris x 8 lane -> 8 blok x 4 word berurutan (r[0] = blok 0-1, r[1] = blok 2-3, ...)
+    inline void transpose4x8(__m256i r[4]) {
+        const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+        const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+        const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+        r[0] = _mm256_permute2x128_si256(u0, u1, 0x20);
+        r[1] = _mm256_permute2x128_si256(u2, u3, 0x20);
+        r[2] = _mm256_permute2x128_si256(u0, u1, 0x31);
+        r[3] = _mm256_permute2x128_si256(u2, u3, 0x31);
+    }
+
+    inline __m256 toUniform8(__m256i x) {
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)), _mm256_set1_ps(1.0f / 16777216.0f));
+    }
+
+    // Sama persis dengan logUnit (mul + add terpisah, tanpa FMA)
+    inline __m256 logUnit8(__m256 u) {
+        const __m256i bits = _mm256_castps_si256(u);
+        __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+        const __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)),
+                                                             _mm256_set1_epi32(0x3F000000)));
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+        __m256 x = _mm256_sub_ps(m, one);
+        e = _mm256_blendv_ps(e, _mm256_sub_ps(e, one), small);
+        x = _mm256_blendv_ps(x, _mm256_add_ps(x, m), small);
+        const __m256 z = _mm256_mul_ps(x, x);
+        const float coeffs[] = {-1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+                                -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f};
+        __m256 p = _mm256_set1_ps(7.0376836292e-2f);
+        for (float k : coeffs) p = _mm256_add_ps(_mm256_mul_ps(p, x), _mm256_set1_ps(k));
+        __m256 y = _mm256_mul_ps(_mm256_mul_ps(p, x), z);
+        y = _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(-2.12194440e-4f)));
+        y = _mm256_sub_ps(y, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+        x = _mm256_add_ps(x, y);
+        return _mm256_add_ps(x, _mm256_mul_ps(e, _mm256_set1_ps(0.693359375f)));
+    }
+
+    inline void sinCosTurn8(__m256i w, __m256& s, __m256& c) {
+        const __m256i t = _mm256_srli_epi32(w, 8);
+        const __m256i q = _mm256_srai_epi32(_mm256_add_epi32(t, _mm256_set1_epi32(1 << 21)), 22);
+        const __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(t, _mm256_slli_epi32(q, 22))),
+                                       _mm256_set1_ps(1.57079632679489662f / 4194304.0f));
+        const __m256 z = _mm256_mul_ps(r, r);
+        __m256 ps = _mm256_set1_ps(-1.9515295891e-4f);
+        ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(8.3321608736e-3f));
+        ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(-1.6666654611e-1f));
+        ps = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, z), r), r);
+        __m256 pc = _mm256_set1_ps(2.443315711809948e-5f);
+        pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(-1.388731625493765e-3f));
+        pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(4.166664568298827e-2f));
+        pc = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(pc, z), z), _mm256_mul_ps(z, _mm256_set1_ps(0.5f))),
+                           _mm256_set1_ps(1.0f));
+        const __m256 swap = _mm256_castsi256_ps(_mm256_slli_epi32(q, 31));
+        const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+        const __m256 cosSign = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+        s = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, swap), sinSign);
+        c = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap), cosSign);
+    }
+
+    // Box-Muller per pasangan word (0,1) dan (2,3) setiap blok -> 4 normal per blok
+    inline void boxMuller8(const __m256i r[4], __m256 out[4]) {
+        const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f), minusTwo = _mm256_set1_ps(-2.0f);
+        for (int pair = 0; pair < 2; ++pair) {
+            const __m256 u = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_srli_epi32(r[2 * pair], 8), _mm256_set1_epi32(1))), scale);
+            const __m256 radius = _mm256_sqrt_ps(_mm256_mul_ps(logUnit8(u), minusTwo));
+            __m256 s, c;
+            sinCosTurn8(r[2 * pair + 1], s, c);
+            out[2 * pair] = _mm256_mul_ps(radius, c);
+            out[2 * pair + 1] = _mm256_mul_ps(radius, s);
+        }
+    }
+#endif
+
+    // 4 normal dari satu blok. Dengan AVX2 blok tunggal juga lewat boxMuller8 (lane 0): compiler boleh
+    // meng-contract mul + add scalar jadi FMA (-mfma), jadi hanya kernel yang sama yang menjamin bit identik
+    inline void normalsFromBlock(const Block& b, float out[4]) {
+#if defined(__AVX2__)
+        const __m256i r[4] = {_mm256_set1_epi32(int(b[0])), _mm256_set1_epi32(int(b[1])),
+                              _mm256_set1_epi32(int(b[2])), _mm256_set1_epi32(int(b[3]))};
+        __m256 v[4];
+        boxMuller8(r, v);
+        for (int k = 0; k < 4; ++k) out[k] = _mm256_cvtss_f32(v[k]);
+#else
+        boxMuller(b[0], b[1], out[0], out[1]);
+        boxMuller(b[2], b[3], out[2], out[3]);
+#endif
+    }
+
+    // Satu stream = (seed, stream, entity, step). Murah dibuat (tidak ada warm-up), jadi job paralel cukup membuat
+    // stream per entity di tempat. Per stream tersedia 2^32 blok (2^34 word).
+    class CounterRng {
+    private:
+        Key key;
+        Block counter; // counter[0] = blok berikutnya
+        Block words{};
+        std::array<float, 4> normals{};
+        uint32_t wordPos = 4, normalPos = 4;
+
+        Block nextBlock() {
+            const Block out = philox4x32(counter, key);
+            ++counter[0];
+            return out;
+        }
+
+        // Blok [counter[0], counter[0] + ceil(n / 4)) -> out; emit8 untuk 8 blok sekaligus, emit untuk sisanya
+        template <typename Emit8, typename Emit>
+        void fillBlocks(float* out, size_t n, Emit8&& emit8, Emit&& emit) {
+            size_t i = 0;
+#if defined(__AVX2__)
+            for (; i + 32 <= n; i += 32) {
+                __m256i r[4];
+                philox8(counter, key, r);
+                emit8(r, out + i);
+                counter[0] += 8;
+            }
+            if (n - i > 4) { // sisa 2..8 blok: satu batch 8 lane lebih murah daripada blok satu per satu
+                __m256i r[4];
+                float values[32];
+                philox8(counter, key, r);
+                emit8(r, values);
+                std::memcpy(out + i, values, (n - i) * sizeof(float));
+                counter[0] += uint32_t((n - i + 3) / 4);
+                return;
+            }
+#else
+            (void)emit8;
+#endif
+            for (; i < n; i += 4) {
+                float values[4];
+                emit(nextBlock(), values);
+                std::memcpy(out + i, values, std::min<size_t>(4, n - i) * sizeof(float));
+            }
+        }
+
+    public:
+        CounterRng(uint32_t seed, uint32_t stream, uint64_t entity, uint32_t step)
+            : key{seed, stream}, counter{0, step, uint32_t(entity), uint32_t(entity >> 32)} {}
+
+        uint32_t nextU32() {
+            if (wordPos == 4) {
+                words = nextBlock();
+                wordPos = 0;
+            }
+            return words[wordPos++];
+        }
+
+        // [0, 1)
+        float uniform() { return toUniform(nextU32()); }
+
+        float uniform(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+
+        // N(0, 1)
+        float normal() {
+            if (normalPos == 4) {
+                normalsFromBlock(nextBlock(), normals.data());
+                normalPos = 0;
+            }
+            return normals[normalPos++];
+        }
+
+        // Batch selalu mulai dari blok baru (sisa word/normal yang di-buffer dibuang) dan memakai ceil(n / 4) blok
+        void fillUniform(float* out, size_t n) {
+            fillBlocks(out, n,
+#if defined(__AVX2__)
+                [](__m256i r[4], float* dst) {
+                    transpose4x8(r);
+                    for (int k = 0; k < 4; ++k) _mm256_storeu_ps(dst + 8 * k, toUniform8(r[k]));
+                },
+#else
+                nullptr,
+#endif
+                [](const Block& b, float* dst) {
+                    for (int k = 0; k < 4; ++k) dst[k] = toUniform(b[k]);
+                });
+            wordPos = normalPos = 4;
+        }
+
+        void fillNormal(float* out, size_t n) {
+            fillBlocks(out, n,
+#if defined(__AVX2__)
+                [](__m256i r[4], float* dst) {
+                    __m256 v[4];
+                    boxMuller8(r, v);
+                    __m256i rows[4];
+                    for (int k = 0; k < 4; ++k) rows[k] = _mm256_castps_si256(v[k]);
+                    transpose4x8(rows);
+                    for (int k = 0; k < 4; ++k) _mm256_storeu_ps(dst + 8 * k, _mm256_castsi256_ps(rows[k]));
+                },
+#else
+                nullptr,
+#endif
+                [](const Block& b, float* dst) { normalsFromBlock(b, dst); });
+            wordPos = normalPos = 4;
+        }
+    };
+}
 
 // =================================================================
-// 3. ENTITY COMPONENT SYSTEM (ECS) CORE
+// 3. PROFILER (Scoped Zones, Chrome Trace Export)
 // =================================================================
 
-class Component {
+// ENGINE_PROFILE_* adalah satu-satunya API yang dipakai kode engine; dengan -DENGINE_PROFILING=0 semuanya hilang.
+// Saat dikompilasi tapi tidak merekam, satu zone hanya berupa load atomic relaxed.
+#ifndef ENGINE_PROFILING
+#define ENGINE_PROFILING 1
+#endif
+#if defined(__x86_64__) && defined(__SSE2__)
+#define ENGINE_PROFILE_TSC 1
+#endif
+
+// Event dicatat ke buffer per thread (satu penulis, tanpa lock); pembaca hanya melihat prefix yang sudah
+// dipublikasikan lewat count (release/acquire), jadi export aman walau thread lain masih merekam.
+// Nama harus berumur sepanjang proses: literal, atau hasil intern().
+// Timestamp berupa tick mentah (TSC di x86-64, jauh lebih murah daripada steady_clock di VM) dan baru
+// dikonversi ke mikrodetik saat export.
+class Profiler {
 public:
-    virtual ~Component() = default;
-    virtual void update(double dt) = 0;
-};
+    using Clock = std::chrono::steady_clock;
+
+    enum class EventKind : uint8_t { Zone, Counter, Frame };
+
+    struct Event {
+        const char* name;
+        int64_t start;
+        union {
+            int64_t duration; // Zone
+            double value;     // Counter, Frame (index)
+        };
+        EventKind kind;
+    };
+
+private:
+    static constexpr size_t kBlockEvents = 8192;
+
+    struct Block {
+        std::array<Event, kBlockEvents> events;
+        std::atomic<size_t> count{0};
+        std::atomic<Block*> next{nullptr};
+    };
+
+    struct ThreadBuffer {
+        uint32_t tid = 0;
+        std::string name;
+        std::atomic<Block*> head{nullptr};
+        Block* tail = nullptr;
+        uint64_t session = 0; // sesi rekam pemilik blok; ditulis pemilik di bawah mtx
+
+        ~ThreadBuffer() { release(); }
+
+        void release() {
+            for (Block* b = head.load(); b;) {
+                Block* next = b->next.load();
+                delete b;
+                b = next;
+            }
+            head.store(nullptr);
+            tail = nullptr;
+        }
+
+        void push(const Event& e) {
+            size_t n = tail ? tail->count.load(std::memory_order_relaxed) : kBlockEvents;
+            if (n == kBlockEvents) {
+                Block* fresh = new Block; // event tidak di-zero: hanya halaman yang ditulis yang dipakai
+                if (tail) {
+                    tail->next.store(fresh, std::memory_order_release);
+                } else {
+                    head.store(fresh, std::memory_order_release);
+                }
+                tail = fresh;
+                n = 0;
+            }
+            tail->events[n] = e;
+            tail->count.store(n + 1, std::memory_order_release);
+        }
+    };
+
+    std::atomic<bool> recording{false};
+    std::atomic<uint64_t> session{0};
+    const int64_t epochTicks = ticks();
+    const Clock::time_point epochTime = Clock::now();
+    std::mutex mtx; // registrasi thread, nama, intern; tidak pernah di jalur rekam
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    std::deque<std::string> interned;
+
+    // noinline: alamat thread_local tidak boleh di-cache melewati pergantian fiber
+    [[gnu::noinline]] static ThreadBuffer*& localSlot() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        return buffer;
+    }
+
+    ThreadBuffer& local() {
+        ThreadBuffer*& buffer = localSlot();
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto fresh = std::make_unique<ThreadBuffer>();
+            fresh->tid = uint32_t(threads.size() + 1);
+            fresh->name = "Thread " + std::to_string(fresh->tid);
+            fresh->session = session.load(std::memory_order_acquire);
+            buffer = fresh.get();
+            threads.push_back(std::move(fresh));
+        } else if (buffer->session != session.load(std::memory_order_acquire)) {
+            recycle(*buffer);
+        }
+        return *buffer;
+    }
+
+    // Blok sesi lama hanya boleh dibebaskan oleh thread pemiliknya (tail dipakai tanpa lock); mtx menahan
+    // export/eventCount yang sedang membaca rantai yang sama
+    void recycle(ThreadBuffer& buffer) {
+        std::lock_guard<std::mutex> lock(mtx);
+        buffer.release();
+        buffer.session = session.load(std::memory_order_acquire);
+    }
+
+    bool isCurrent(const ThreadBuffer& buffer) const { return buffer.session == session.load(std::memory_order_acquire); }
+
+    // Kalibrasi tick -> ns terhadap steady_clock sejak profiler dibuat (minimal 20 ms supaya akurat)
+    double nanosecondsPerTick() const {
+#if defined(ENGINE_PROFILE_TSC)
+        while (Clock::now() - epochTime < std::chrono::milliseconds(20)) std::this_thread::yield();
+        const int64_t elapsedTicks = ticks() - epochTicks;
+        const double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - epochTime).count();
+        return elapsedNs / double(std::max<int64_t>(elapsedTicks, 1));
+#else
+        return 1.0;
+#endif
+    }
+
+    static void appendEscaped(std::string& out, const char* s) {
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') out += '\\';
+            out += *s;
+        }
+    }
+
+    // Mikrodetik dengan 3 desimal tanpa format floating point
+    static void appendMicros(std::string& out, double ns) {
+        const int64_t rounded = int64_t(ns + 0.5);
+        out += std::to_string(rounded / 1000);
+        const int64_t frac = rounded % 1000;
+        out += '.';
+        out += char('0' + frac / 100);
+        out += char('0' + frac / 10 % 10);
+        out += char('0' + frac % 10);
+    }
 
-class TransformComponent : public Component {
 public:
-    Engine::Math::Vector3 position;
-    Engine::Math::Vector3 rotation;
-    
-    TransformComponent(double x, double y, double z) : position(x, y, z) {}
-    
-    void update(double dt) override {
-        position.x += 0.01 * dt; // Simulasi pergerakan konstan
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    static int64_t ticks() {
+#if defined(ENGINE_PROFILE_TSC)
+        return int64_t(__rdtsc());
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+    void start() {
+        clear();
+        recording.store(true);
+    }
+    void stop() { recording.store(false); }
+
+    // Buang semua event yang sudah direkam: blok thread pemanggil langsung dibebaskan, thread lain
+    // membebaskan bloknya sendiri saat merekam lagi; sampai itu terjadi bloknya tidak ikut diekspor
+    void clear() {
+        session.fetch_add(1);
+        if (ThreadBuffer* buffer = localSlot()) recycle(*buffer);
+    }
+
+    void zone(const char* name, int64_t startTicks, int64_t endTicks) {
+        Event e;
+        e.name = name;
+        e.start = startTicks;
+        e.duration = endTicks - startTicks;
+        e.kind = EventKind::Zone;
+        local().push(e);
+    }
+
+    void counter(const char* name, double value, EventKind kind = EventKind::Counter) {
+        if (!isRecording()) return;
+        Event e;
+        e.name = name;
+        e.start = ticks();
+        e.value = value;
+        e.kind = kind;
+        local().push(e);
+    }
+
+    void frameMark(uint64_t index) { counter("Frame", double(index), EventKind::Frame); }
+
+    void setThreadName(const std::string& name) {
+        ThreadBuffer& buffer = local();
+        std::lock_guard<std::mutex> lock(mtx);
+        buffer.name = name;
+    }
+
+    // Salinan stabil untuk nama dinamis (mis. nama system); panggil sekali saat registrasi, bukan per frame
+    const char* intern(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const std::string& s : interned) {
+            if (s == name) return s.c_str();
+        }
+        interned.push_back(name);
+        return interned.back().c_str();
+    }
+
+    size_t eventCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t total = 0;
+        for (const auto& t : threads) {
+            if (!isCurrent(*t)) continue;
+            for (Block* b = t->head.load(std::memory_order_acquire); b; b = b->next.load(std::memory_order_acquire)) {
+                total += b->count.load(std::memory_order_acquire);
+            }
+        }
+        return total;
+    }
+
+    // Format Trace Event JSON (chrome://tracing, ui.perfetto.dev): zone = "X" (durasi), counter = "C",
+    // batas frame = instant global "i". Timestamp dalam mikrodetik sejak profiler dibuat.
+    size_t writeChromeTrace(const std::string& path) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) throw std::runtime_error("Cannot write profile trace: " + path);
+
+        const double scale = nanosecondsPerTick();
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t written = 0;
+        std::string line;
+        char number[32];
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto& t : threads) {
+            if (!isCurrent(*t)) continue;
+            const std::string tid = std::to_string(t->tid);
+            line = first ? "\n" : ",\n";
+            first = false;
+            line += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+            appendEscaped(line, t->name.c_str());
+            line += "\"}}";
+            out << line;
+            for (Block* b = t->head.load(std::memory_order_acquire); b; b = b->next.load(std::memory_order_acquire)) {
+                const size_t n = b->count.load(std::memory_order_acquire);
+                line.clear();
+                for (size_t i = 0; i < n; ++i) {
+                    const Event& e = b->events[i];
+                    line += ",\n{\"name\":\"";
+                    appendEscaped(line, e.name);
+                    line += "\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+                    appendMicros(line, double(e.start - epochTicks) * scale);
+                    switch (e.kind) {
+                    case EventKind::Zone:
+                        line += ",\"ph\":\"X\",\"dur\":";
+                        appendMicros(line, double(e.duration) * scale);
+                        line += "}";
+                        break;
+                    case EventKind::Counter:
+                        std::snprintf(number, sizeof(number), "%.9g", e.value);
+                        line += ",\"ph\":\"C\",\"args\":{\"value\":" + std::string(number) + "}}";
+                        break;
+                    case EventKind::Frame:
+                        line += ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"frame\":" + std::to_string(uint64_t(e.value)) + "}}";
+                        break;
+                    }
+                }
+                out << line;
+                written += n;
+            }
+        }
+        out << "\n]}\n";
+        if (!out) throw std::runtime_error("Cannot write profile trace: " + path);
+        return written;
     }
 };
 
-class MeshComponent : public Component {
-public:
-    std::string modelPath;
-    int vertexCount;
+// Zone dicatat sebagai satu event saat scope berakhir. Dalam fiber job, zone tidak boleh melewati waitFor:
+// fiber bisa selesai di thread lain dan zone-nya akan muncul di track yang salah.
+class ProfileZone {
+private:
+    const char* name;
+    int64_t start = 0;
+    bool active;
 
-    MeshComponent(std::string path) : modelPath(path), vertexCount(1000) {}
+public:
+    explicit ProfileZone(const char* zoneName) : name(zoneName), active(Profiler::getInstance().isRecording()) {
+        if (active) start = Profiler::ticks();
+    }
 
-    void update(double dt) override {
-        // Render logic biasanya di sini
+    ~ProfileZone() {
+        if (active) Profiler::getInstance().zone(name, start, Profiler::ticks());
     }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
 };
 
-class Entity {
-    size_t id;
-    std::vector<std::unique_ptr<Component>> components;
+#if ENGINE_PROFILING
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+#define ENGINE_PROFILE_ZONE(name) ProfileZone ENGINE_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define ENGINE_PROFILE_COUNTER(name, value) Profiler::getInstance().counter(name, double(value))
+#define ENGINE_PROFILE_FRAME(index) Profiler::getInstance().frameMark(uint64_t(index))
+#define ENGINE_PROFILE_THREAD(name) Profiler::getInstance().setThreadName(name)
+#else
+#define ENGINE_PROFILE_ZONE(name) ((void)0)
+#define ENGINE_PROFILE_COUNTER(name, value) ((void)0)
+#define ENGINE_PROFILE_FRAME(index) ((void)0)
+#define ENGINE_PROFILE_THREAD(name) ((void)0)
+#endif
 
+// Counter hardware (perf_event_open) untuk satu blok kode di thread pemanggil, khusus benchmark.
+// Counter yang tidak didukung (VM tanpa PMU, perf_event_paranoid ketat, non-Linux) dilewati; cek available().
+class PerfCounters {
 public:
-    Entity(size_t _id) : id(_id) {}
+    enum Counter : size_t { CacheReferences, CacheMisses, L1dReadMisses, Count };
+    static constexpr const char* kNames[Count] = {"cache-references", "cache-misses", "L1d-read-misses"};
 
-    template <typename T, typename... Args>
-    void addComponent(Args&&... args) {
-        components.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+private:
+    std::array<int, Count> fds;
+    std::string failure;
+
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#if defined(__linux__)
+        const std::pair<uint32_t, uint64_t> events[Count] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        };
+        for (size_t i = 0; i < Count; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[i] < 0 && failure.empty()) failure = std::strerror(errno);
+        }
+#else
+        failure = "perf_event_open requires Linux";
+#endif
     }
 
-    void update(double dt) {
-        for (auto& comp : components) comp->update(dt);
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(Counter c) const { return fds[c] >= 0; }
+    bool anyAvailable() const { return std::any_of(fds.begin(), fds.end(), [](int fd) { return fd >= 0; }); }
+    const std::string& unavailableReason() const { return failure; }
+
+    void start() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Nilai sejak start(); 0 untuk counter yang tidak tersedia
+    std::array<uint64_t, Count> stop() {
+        std::array<uint64_t, Count> values{};
+#if defined(__linux__)
+        for (size_t i = 0; i < Count; ++i) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &values[i], sizeof(uint64_t)) != ssize_t(sizeof(uint64_t))) values[i] = 0;
+        }
+#endif
+        return values;
     }
-    
-    size_t getId() const { return id; }
 };
 
 // =================================================================
-// 4. SCENE GRAPH & EVENT SYSTEM
+// 4. CONCURRENCY: WORKER POOL
 // =================================================================
 
-class SceneManager {
+class WorkerPool {
 private:
-    std::vector<std::shared_ptr<Entity>> entities;
-    std::map<std::string, std::function<void()>> eventCallbacks;
+    // group: tanda milik siapa task ini (biasanya alamat counter yang ditunggu); nullptr = tanpa grup
+    struct Task {
+        const void* group;
+        std::function<void()> fn;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Task> tasks;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void workerLoop() {
+        ENGINE_PROFILE_THREAD("Worker Pool");
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front().fn);
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
 
 public:
-    void addEntity(std::shared_ptr<Entity> e) {
-        entities.push_back(e);
+    explicit WorkerPool(size_t threadCount = std::thread::hardware_concurrency()) {
+        // Thread pemanggil ikut bekerja, jadi cukup N-1 worker tambahan
+        size_t extra = threadCount > 1 ? threadCount - 1 : 0;
+        for (size_t i = 0; i < extra; ++i) {
+            workers.emplace_back(&WorkerPool::workerLoop, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers) t.join();
     }
 
-    void onEvent(const std::string& eventName, std::function<void()> callback) {
-        eventCallbacks[eventName] = callback;
+    static WorkerPool& getInstance() {
+        static WorkerPool instance;
+        return instance;
     }
 
-    void triggerEvent(const std::string& eventName) {
-        if (eventCallbacks.count(eventName)) {
-            eventCallbacks[eventName]();
+    size_t threadCount() const { return workers.size() + 1; }
+
+    void submit(std::function<void()> task, const void* group = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tasks.push_back({group, std::move(task)});
         }
+        cv.notify_one();
     }
 
-    void update(double dt) {
-        for (auto& entity : entities) {
-            entity->update(dt);
+    // Jalankan satu task milik `group` jika ada, yang terbaru dulu; dipakai thread yang sedang menunggu supaya tidak diam
+    bool runPendingTask(const void* group) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto it = std::find_if(tasks.rbegin(), tasks.rend(), [&](const Task& t) { return t.group == group; });
+            if (it == tasks.rend()) return false;
+            task = std::move(it->fn);
+            tasks.erase(std::next(it).base());
+        }
+        task();
+        return true;
+    }
+
+    // Menunggu sambil membantu, tapi hanya task dari grup yang ditunggu: task asing tidak menumpuk di stack
+    // penunggu, jadi kedalaman nesting dibatasi kedalaman fork-join itu sendiri. Tetap bebas deadlock karena
+    // task grup ini yang sudah diambil thread lain pasti sedang berjalan di sana.
+    template <typename Pred>
+    void waitUntil(const void* group, Pred done) {
+        while (!done()) {
+            if (!runPendingTask(group)) std::this_thread::yield();
+        }
+    }
+
+    // Runs fn(begin, end) over [0, count) in chunks of `grain`; blocks until every chunk is done.
+    // Setiap peserta mendapat blok chunk berurutan; yang selesai duluan mencuri separuh blok peserta lain.
+    // Batas chunk hanya bergantung pada `grain`, bukan jumlah thread.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1 || workers.empty()) {
+            fn(0, count);
+            return;
+        }
+
+        const size_t participants = std::min(workers.size(), chunks - 1) + 1;
+        std::unique_ptr<StealRange[]> ranges(new StealRange[participants]);
+        for (size_t p = 0; p < participants; ++p) {
+            ranges[p].store(uint32_t(chunks * p / participants), uint32_t(chunks * (p + 1) / participants));
+        }
+
+        auto runChunk = [&](uint32_t c) {
+            size_t begin = size_t(c) * grain;
+            fn(begin, std::min(begin + grain, count));
+        };
+        auto work = [&](size_t self) {
+            while (true) {
+                uint32_t c, b, e;
+                while (ranges[self].popFront(c)) runChunk(c);
+                bool stole = false;
+                for (size_t k = 1; k < participants && !stole; ++k) {
+                    if (ranges[(self + k) % participants].stealBack(b, e)) {
+                        ranges[self].store(b, e);
+                        stole = true;
+                    }
+                }
+                if (!stole) return;
+            }
+        };
+
+        std::atomic<size_t> nextSlot{1};
+        std::atomic<size_t> pending{participants - 1};
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (size_t i = 1; i < participants; ++i) {
+                tasks.push_back({&pending, [&] {
+                    work(nextSlot.fetch_add(1));
+                    pending.fetch_sub(1);
+                }});
+            }
         }
+        cv.notify_all();
+
+        work(0);
+        waitUntil(&pending, [&] { return pending.load() == 0; });
     }
+
+private:
+    // [begin, end) chunk dalam satu kata 64-bit supaya pemilik (depan) dan pencuri (belakang) cukup satu CAS
+    struct alignas(64) StealRange {
+        std::atomic<uint64_t> bits{0};
+
+        void store(uint32_t begin, uint32_t end) { bits.store((uint64_t(begin) << 32) | end); }
+
+        bool popFront(uint32_t& chunk) {
+            uint64_t cur = bits.load();
+            while (true) {
+                uint32_t b = uint32_t(cur >> 32), e = uint32_t(cur);
+                if (b >= e) return false;
+                if (bits.compare_exchange_weak(cur, (uint64_t(b + 1) << 32) | e)) {
+                    chunk = b;
+                    return true;
+                }
+            }
+        }
+
+        bool stealBack(uint32_t& begin, uint32_t& end) {
+            uint64_t cur = bits.load();
+            while (true) {
+                uint32_t b = uint32_t(cur >> 32), e = uint32_t(cur);
+                if (b >= e) return false;
+                uint32_t mid = b + (e - b) / 2;
+                if (bits.compare_exchange_weak(cur, (uint64_t(b) << 32) | mid)) {
+                    begin = mid;
+                    end = e;
+                    return true;
+                }
+            }
+        }
+    };
 };
 
 // =================================================================
-// 5. RENDER ENGINE MAIN LOOP
+// 5. CONCURRENCY: FIBER JOB SYSTEM
 // =================================================================
 
-class RenderEngine {
+// Job yang memanggil waitFor tidak memblokir worker thread: konteksnya (register + stack fiber sendiri) disimpan,
+// thread langsung mengambil job atau fiber lain yang sudah siap, dan fiber dilanjutkan begitu counter-nya turun.
+// Fiber bisa dilanjutkan di thread lain dari tempat ia berhenti, jadi state per-job disimpan di FiberLocal,
+// bukan thread_local.
+
+// swapcontext menyimpan/memulihkan signal mask lewat syscall di setiap switch; di x86-64 Linux cukup
+// register callee-saved + MXCSR/x87 control word yang ditukar, sepenuhnya di user mode.
+#if defined(__x86_64__) && defined(__linux__)
+#define ENGINE_ASM_FIBERS 1
+extern "C" void engine_fiber_switch(void** saveSp, void* loadSp);
+extern "C" void engine_fiber_start();
+asm(R"(
+    .text
+    .p2align 4
+    .globl engine_fiber_switch
+    .type engine_fiber_switch, @function
+engine_fiber_switch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size engine_fiber_switch, .-engine_fiber_switch
+
+    .p2align 4
+    .globl engine_fiber_start
+    .type engine_fiber_start, @function
+engine_fiber_start:
+    movq %r12, %rdi
+    callq *%r13
+    ud2
+    .size engine_fiber_start, .-engine_fiber_start
+)");
+#endif
+
+// Jumlah job yang belum selesai. Exception pertama dari job yang tercatat di counter dilempar ulang oleh waitFor.
+class JobCounter {
 private:
-    bool isRunning;
-    SceneManager scene;
-    PhongShader currentShader;
+    friend class FiberScheduler;
+    std::atomic<int> value{0};
+    std::exception_ptr failure;
 
 public:
-    RenderEngine() : isRunning(false) {}
+    int pending() const { return value.load(); }
+};
 
-    void initialize() {
-        std::cout << "--- Initializing Procedural Render Engine ---" << std::endl;
-        isRunning = true;
+constexpr size_t kMaxFiberLocals = 16;
 
-        // Setup Scene
-        auto player = std::make_shared<Entity>(1);
-        player->addComponent<TransformComponent>(0.0, 5.0, -10.0);
-        player->addComponent<MeshComponent>("assets/hero.obj");
-        
-        scene.addEntity(player);
+class FiberScheduler {
+private:
+    template <typename> friend class FiberLocal;
 
-        scene.onEvent("OnCrash", [](){
-            std::cout << "!!! ALERT: Engine detected a collision event !!!" << std::endl;
-        });
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter = nullptr;
+    };
+
+    struct LocalSlot {
+        void* value = nullptr;
+        void (*destroy)(void*) = nullptr;
+    };
+
+    enum class FiberState { Running, Finished, Waiting };
+
+    struct Context {
+#if defined(ENGINE_ASM_FIBERS)
+        void* sp = nullptr;
+#else
+        ucontext_t uc;
+#endif
+    };
+
+    struct Fiber {
+        Context context;
+        FiberScheduler* owner = nullptr;
+        std::byte* stack = nullptr;
+        size_t stackBytes = 0;
+        Job job;
+        FiberState state = FiberState::Finished;
+        JobCounter* waitCounter = nullptr;
+        int waitTarget = 0;
+        std::array<LocalSlot, kMaxFiberLocals> locals{};
+        void* tsanFiber = nullptr;
+    };
+
+    // Konteks scheduler satu thread; fiber kembali ke sini saat job selesai atau menunggu
+    struct WorkerContext {
+        Context context;
+        Fiber* running = nullptr;
+        void* tsanFiber = nullptr;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Fiber>> fibers;
+    std::vector<Fiber*> idle;
+    std::deque<Fiber*> ready;   // fiber yang counter-nya sudah tercapai
+    std::vector<Fiber*> waiting;
+    std::deque<Job> jobs;
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t stackBytes;
+    int sleepers = 0;        // thread yang sedang tidur di cv
+    int externalWaiters = 0; // waitFor dari luar fiber; predikatnya hanya bisa dicek oleh thread itu sendiri
+    bool stopping = false;
+
+    // noinline: alamat thread_local tidak boleh di-cache melewati swapcontext, karena fiber bisa pindah thread
+    [[gnu::noinline]] static WorkerContext*& currentWorker() {
+        thread_local WorkerContext* worker = nullptr;
+        return worker;
     }
 
-    void processInput() {
-        // Simulasi input async
+    static void switchTo(Context& from, Context& to, [[maybe_unused]] void* tsanFiber) {
+#if defined(ENGINE_TSAN_FIBERS)
+        __tsan_switch_to_fiber(tsanFiber, 0);
+#endif
+#if defined(ENGINE_ASM_FIBERS)
+        engine_fiber_switch(&from.sp, to.sp);
+#else
+        swapcontext(&from.uc, &to.uc);
+#endif
     }
 
-    void update(double deltaTime) {
-        scene.update(deltaTime);
-        
-        // Simulasi logika kompleks
-        if (std::rand() % 100 > 95) {
-            scene.triggerEvent("OnCrash");
+#if !defined(ENGINE_ASM_FIBERS)
+    static void fiberEntry(unsigned lo, unsigned hi) {
+        fiberMain(reinterpret_cast<Fiber*>((uintptr_t(hi) << 32) | uintptr_t(lo)));
+    }
+#endif
+
+    static void fiberMain(Fiber* fiber) {
+        while (true) {
+            try {
+                fiber->job.fn();
+            } catch (...) {
+                fiber->owner->fail(*fiber->job.counter, std::current_exception());
+            }
+            fiber->job.fn = nullptr;
+            fiber->owner->complete(*fiber->job.counter);
+            fiber->state = FiberState::Finished;
+            WorkerContext* worker = currentWorker();
+            switchTo(fiber->context, worker->context, worker->tsanFiber);
         }
     }
 
-    void render() {
-        currentShader.execute();
-        std::cout << "[Render] Flushing buffers to GPU... Frame Rendered." << std::endl;
+    // Stack di-mmap dengan guard page di bawahnya supaya overflow langsung crash, bukan menimpa fiber lain
+    Fiber* createFiber() {
+        auto fiber = std::make_unique<Fiber>();
+        fiber->owner = this;
+        const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+        fiber->stackBytes = (stackBytes + page - 1) / page * page + page;
+        void* p = ::mmap(nullptr, fiber->stackBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot allocate fiber stack");
+        fiber->stack = static_cast<std::byte*>(p);
+        ::mprotect(fiber->stack, page, PROT_NONE);
+
+#if defined(ENGINE_ASM_FIBERS)
+        // Frame awal sesuai urutan pop engine_fiber_switch: MXCSR/FCW, r15, r14, r13, r12, rbx, rbp, alamat return.
+        // r12 = fiber, r13 = fiberMain; setelah ret, rsp ter-align 16 seperti tepat sebelum call.
+        uint64_t* frame = reinterpret_cast<uint64_t*>(fiber->stack + fiber->stackBytes) - 8;
+        frame[0] = 0x1F80u | (uint64_t(0x037Fu) << 32);
+        frame[1] = frame[2] = frame[5] = frame[6] = 0;
+        frame[3] = reinterpret_cast<uint64_t>(&FiberScheduler::fiberMain);
+        frame[4] = reinterpret_cast<uint64_t>(fiber.get());
+        frame[7] = reinterpret_cast<uint64_t>(&engine_fiber_start);
+        fiber->context.sp = frame;
+#else
+        getcontext(&fiber->context.uc);
+        fiber->context.uc.uc_stack.ss_sp = fiber->stack + page;
+        fiber->context.uc.uc_stack.ss_size = fiber->stackBytes - page;
+        fiber->context.uc.uc_link = nullptr;
+        const uintptr_t self = reinterpret_cast<uintptr_t>(fiber.get());
+        makecontext(&fiber->context.uc, reinterpret_cast<void (*)()>(&FiberScheduler::fiberEntry), 2, unsigned(self), unsigned(self >> 32));
+#endif
+#if defined(ENGINE_TSAN_FIBERS)
+        fiber->tsanFiber = __tsan_create_fiber(0);
+#endif
+        fibers.push_back(std::move(fiber));
+        return fibers.back().get();
     }
 
-    void start() {
-        initialize();
-        double deltaTime = 0.016; // Simulasi 60 FPS
+    void fail(JobCounter& counter, std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!counter.failure) counter.failure = error;
+    }
 
-        for (int frame = 0; frame < 10; ++frame) {
-            std::cout << "\n--- Processing Frame: " << frame << " ---" << std::endl;
-            processInput();
-            update(deltaTime);
-            render();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Hanya membangunkan thread jika ada yang berubah untuknya; thread ini sendiri akan mengambil fiber yang siap
+    void complete(JobCounter& counter) {
+        std::unique_lock<std::mutex> lock(mtx);
+        const int remaining = counter.value.fetch_sub(1) - 1;
+        size_t resumed = 0;
+        for (size_t i = 0; i < waiting.size();) {
+            if (waiting[i]->waitCounter == &counter && remaining <= waiting[i]->waitTarget) {
+                ready.push_back(waiting[i]);
+                waiting[i] = waiting.back();
+                waiting.pop_back();
+                ++resumed;
+            } else {
+                ++i;
+            }
+        }
+        const bool wakeAll = externalWaiters > 0 && sleepers > 0;
+        const bool wakeOne = resumed > 1 && sleepers > 0;
+        lock.unlock();
+        if (wakeAll) {
+            cv.notify_all();
+        } else if (wakeOne) {
+            cv.notify_one();
         }
     }
-};
 
-// =================================================================
-// 6. ENTRY POINT
-// =================================================================
+    // Loop scheduler: jalankan fiber siap atau job baru di fiber bebas sampai done() (atau scheduler berhenti)
+    template <typename Done>
+    void schedule(WorkerContext& self, Done done) {
+#if defined(ENGINE_TSAN_FIBERS)
+        self.tsanFiber = __tsan_get_current_fiber();
+#endif
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            ++sleepers;
+            cv.wait(lock, [&] { return stopping || done() || !ready.empty() || !jobs.empty(); });
+            --sleepers;
+            if (stopping || done()) return;
 
-int main() {
-    try {
-        RenderEngine engine;
+            Fiber* fiber;
+            if (!ready.empty()) {
+                fiber = ready.front();
+                ready.pop_front();
+            } else {
+                if (idle.empty()) idle.push_back(createFiber()); // semua fiber sedang menunggu: tambah, jangan deadlock
+                fiber = idle.back();
+                idle.pop_back();
+                fiber->job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            lock.unlock();
+
+            fiber->state = FiberState::Running;
+            self.running = fiber;
+            switchTo(self.context, fiber->context, fiber->tsanFiber);
+            self.running = nullptr;
+
+            // Fiber baru boleh diambil thread lain setelah konteksnya selesai disimpan, yaitu di sini
+            if (fiber->state == FiberState::Finished) {
+                for (LocalSlot& slot : fiber->locals) {
+                    if (slot.value) slot.destroy(slot.value);
+                    slot = LocalSlot{};
+                }
+            }
+            lock.lock();
+            if (fiber->state == FiberState::Finished) {
+                idle.push_back(fiber);
+            } else if (fiber->waitCounter->value.load() <= fiber->waitTarget) {
+                ready.push_back(fiber);
+            } else {
+                waiting.push_back(fiber);
+            }
+        }
+    }
+
+    static LocalSlot& currentLocal(size_t slot) {
+        WorkerContext* worker = currentWorker();
+        if (!worker || !worker->running) throw std::runtime_error("FiberLocal accessed outside a fiber job");
+        return worker->running->locals[slot];
+    }
+
+    static size_t allocateLocalSlot() {
+        static std::atomic<size_t> next{0};
+        size_t slot = next.fetch_add(1);
+        if (slot >= kMaxFiberLocals) throw std::runtime_error("Too many FiberLocal slots");
+        return slot;
+    }
+
+public:
+    // Thread pemanggil waitFor ikut menjalankan job, jadi cukup N-1 worker tambahan (sama seperti WorkerPool)
+    explicit FiberScheduler(size_t threadCount = std::thread::hardware_concurrency(), size_t fiberCount = 16,
+                            size_t stackBytes = 512 * 1024)
+        : stackBytes(stackBytes) {
+        for (size_t i = 0; i < fiberCount; ++i) idle.push_back(createFiber());
+        size_t extra = threadCount > 1 ? threadCount - 1 : 0;
+        for (size_t i = 0; i < extra; ++i) {
+            workers.emplace_back([this] {
+                ENGINE_PROFILE_THREAD("Fiber Worker");
+                WorkerContext self;
+                currentWorker() = &self;
+                schedule(self, [] { return false; });
+                currentWorker() = nullptr;
+            });
+        }
+    }
+
+    // Semua counter harus sudah ditunggu; job yang belum berjalan dibuang
+    ~FiberScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto& t : workers) t.join();
+        for (auto& fiber : fibers) {
+#if defined(ENGINE_TSAN_FIBERS)
+            __tsan_destroy_fiber(fiber->tsanFiber);
+#endif
+            ::munmap(fiber->stack, fiber->stackBytes);
+        }
+    }
+
+    FiberScheduler(const FiberScheduler&) = delete;
+    FiberScheduler& operator=(const FiberScheduler&) = delete;
+
+    size_t threadCount() const { return workers.size() + 1; }
+    size_t fiberCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return fibers.size();
+    }
+
+    void run(std::function<void()> fn, JobCounter& counter) {
+        counter.value.fetch_add(1);
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            jobs.push_back({std::move(fn), &counter});
+            wake = sleepers > 0;
+        }
+        if (wake) cv.notify_one();
+    }
+
+    // Menunggu sampai counter <= target. Dari dalam job: fiber diparkir dan worker lanjut ke pekerjaan lain.
+    // Dari thread biasa: thread ini ikut menjalankan job sampai counter tercapai.
+    void waitFor(JobCounter& counter, int target = 0) {
+        if (counter.value.load() > target) {
+            WorkerContext* worker = currentWorker();
+            if (worker && worker->running && worker->running->owner == this) {
+                Fiber* fiber = worker->running;
+                fiber->waitCounter = &counter;
+                fiber->waitTarget = target;
+                fiber->state = FiberState::Waiting;
+                switchTo(fiber->context, worker->context, worker->tsanFiber);
+                // Dilanjutkan oleh thread mana pun yang mengambilnya dari antrean ready
+            } else {
+                WorkerContext self;
+                WorkerContext* previous = worker;
+                currentWorker() = &self;
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    ++externalWaiters;
+                }
+                schedule(self, [&] { return counter.value.load() <= target; });
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    --externalWaiters;
+                }
+                currentWorker() = previous;
+            }
+        }
+
+        std::exception_ptr failure;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            failure = std::exchange(counter.failure, nullptr);
+        }
+        if (failure) std::rethrow_exception(failure);
+    }
+};
+
+// Satu nilai T per job (dibuat saat pertama diakses, dihancurkan saat job selesai). Slot berlaku untuk seluruh
+// proses, seperti key TLS, jadi FiberLocal sebaiknya static / berumur panjang.
+template <typename T>
+class FiberLocal {
+private:
+    size_t slot;
+
+public:
+    FiberLocal() : slot(FiberScheduler::allocateLocalSlot()) {}
+
+    T& get() {
+        FiberScheduler::LocalSlot& s = FiberScheduler::currentLocal(slot);
+        if (!s.value) {
+            s.value = new T();
+            s.destroy = [](void* p) { delete static_cast<T*>(p); };
+        }
+        return *static_cast<T*>(s.value);
+    }
+};
+
+// =================================================================
+// 6. MEMORY: FRAME ARENA (Linear Bump Allocators)
+// =================================================================
+
+// Data sementara (daftar kerja scheduler, frontier BFS, proxy render) dialokasikan dengan menggeser pointer
+// dan dibebaskan sekaligus: rewind ke marker, atau reset di akhir frame, O(1). Blok tidak pernah dikembalikan
+// ke heap, jadi setelah frame pertama kapasitasnya stabil di puncak pemakaian dan tidak ada panggilan new/delete.
+// Satu arena hanya boleh dipakai satu thread pada satu waktu.
+class LinearArena {
+public:
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+private:
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0; // blok aktif
+    size_t offset = 0;  // posisi bump di blok aktif
+    size_t blockBytes;
+
+    void* bump(size_t bytes, size_t align) {
+        const Block& b = blocks[current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+        const size_t start = size_t(((base + offset + align - 1) & ~uintptr_t(align - 1)) - base);
+        if (start + bytes > b.size) return nullptr;
+        offset = start + bytes;
+        return b.data + start;
+    }
+
+    Block newBlock(size_t minBytes) {
+        const size_t size = std::max(blockBytes, minBytes);
+        return {static_cast<std::byte*>(::operator new(size, std::align_val_t(kCacheLine))), size};
+    }
+
+public:
+    static constexpr size_t kCacheLine = 64;
+
+    explicit LinearArena(size_t blockBytes = 64 * 1024) : blockBytes(blockBytes) {}
+
+    ~LinearArena() {
+        for (const Block& b : blocks) ::operator delete(b.data, std::align_val_t(kCacheLine));
+    }
+
+    LinearArena(LinearArena&& other) noexcept
+        : blocks(std::move(other.blocks)), current(other.current), offset(other.offset), blockBytes(other.blockBytes) {
+        other.blocks.clear();
+        other.current = other.offset = 0;
+    }
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    LinearArena& operator=(LinearArena&&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        if (!blocks.empty()) {
+            if (void* p = bump(bytes, align)) return p;
+            // Blok berikutnya (sisa dari frame lalu) dipakai ulang jika cukup; blok besar disisipkan di sini
+            ++current;
+            offset = 0;
+            if (current == blocks.size() || blocks[current].size < bytes + align) {
+                blocks.insert(blocks.begin() + ptrdiff_t(current), newBlock(bytes + align));
+            }
+        } else {
+            blocks.push_back(newBlock(bytes + align));
+        }
+        return bump(bytes, align);
+    }
+
+    // Hanya alokasi teratas yang benar-benar dikembalikan (mis. vector yang menyusut / buffer terakhir)
+    void deallocate(void* p, size_t bytes) {
+        if (blocks.empty()) return;
+        std::byte* top = blocks[current].data + offset;
+        std::byte* q = static_cast<std::byte*>(p);
+        if (q >= blocks[current].data && q + bytes == top) offset = size_t(q - blocks[current].data);
+    }
+
+    Marker mark() const { return {current, offset}; }
+
+    void rewind(Marker m) {
+        current = m.block;
+        offset = m.offset;
+    }
+
+    void reset() { rewind({}); }
+
+    size_t bytesUsed() const {
+        size_t used = offset;
+        for (size_t i = 0; i < current && i < blocks.size(); ++i) used += blocks[i].size;
+        return used;
+    }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Block& b : blocks) total += b.size;
+        return total;
+    }
+
+    // Scratch per thread untuk data yang hidup dalam satu scope (lihat ArenaScope).
+    // noinline: alamat thread_local tidak boleh di-cache melewati pergantian fiber.
+    [[gnu::noinline]] static LinearArena& threadScratch() {
+        thread_local LinearArena scratch;
+        return scratch;
+    }
+};
+
+// Adapter STL: container memakai arena tanpa panggilan heap. Allocator default (tanpa arena) hanya untuk
+// container kosong; alokasi darinya melempar std::bad_alloc.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    LinearArena* arena = nullptr;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(LinearArena& a) noexcept : arena(&a) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        if (!arena) throw std::bad_alloc();
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (arena) arena->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Semua yang dialokasikan dari arena selama scope ini hidup dibebaskan saat scope berakhir. Deklarasikan scope
+// sebelum container-nya. Di dalam fiber job, scope tidak boleh melewati waitFor: fiber bisa dilanjutkan di
+// thread lain, sementara scratch milik thread lama sudah dipakai fiber berikutnya.
+class ArenaScope {
+private:
+    LinearArena& arena;
+    LinearArena::Marker marker;
+
+public:
+    explicit ArenaScope(LinearArena& a = LinearArena::threadScratch()) : arena(a), marker(a.mark()) {}
+    ~ArenaScope() { arena.rewind(marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    template <typename T>
+    ArenaAllocator<T> allocator() const { return ArenaAllocator<T>(arena); }
+};
+
+// Arena per thread per frame, di-buffer `frames` kali: data frame N tetap valid sampai beginFrame ke-N+frames,
+// jadi data yang menyeberang pipeline update/render cukup dialokasikan di sini (double buffer untuk simulasi
+// yang paling banyak satu frame di depan render, triple untuk dua frame). beginFrame me-reset arena slot yang
+// dipakai ulang di semua thread; pemanggil menjamin tidak ada yang masih membaca / menulis frame tersebut.
+class FrameArena {
+private:
+    struct ThreadArenas {
+        std::vector<LinearArena> frames;
+    };
+
+    static inline std::atomic<uint64_t> nextId{1};
+    const uint64_t id = nextId.fetch_add(1);
+    const std::shared_ptr<const bool> alive = std::make_shared<const bool>(true); // lihat local()
+    const size_t frameCount;
+    const size_t blockBytes;
+    std::atomic<uint64_t> frame{0};
+    std::mutex mtx;
+    std::vector<std::unique_ptr<ThreadArenas>> threads;
+
+public:
+    explicit FrameArena(size_t frames = 2, size_t blockBytes = 256 * 1024)
+        : frameCount(std::max<size_t>(frames, 1)), blockBytes(blockBytes) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    size_t bufferedFrames() const { return frameCount; }
+    uint64_t frameIndex() const { return frame.load(); }
+
+    void beginFrame() {
+        std::lock_guard<std::mutex> lock(mtx);
+        const uint64_t next = frame.load() + 1;
+        for (auto& t : threads) t->frames[next % frameCount].reset();
+        frame.store(next);
+    }
+
+    // Arena frame aktif milik thread pemanggil; thread baru didaftarkan sekali (cache thread_local).
+    // Entri untuk FrameArena yang sudah dihancurkan dibuang saat cache miss, jadi cache tidak tumbuh terus.
+    [[gnu::noinline]] LinearArena& local() {
+        struct CacheEntry {
+            uint64_t owner;
+            ThreadArenas* arenas;
+            std::weak_ptr<const bool> alive;
+        };
+        thread_local std::vector<CacheEntry> cache;
+        for (const CacheEntry& entry : cache) {
+            if (entry.owner == id) return entry.arenas->frames[frame.load() % frameCount];
+        }
+        cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CacheEntry& e) { return e.alive.expired(); }), cache.end());
+        std::lock_guard<std::mutex> lock(mtx);
+        auto arenas = std::make_unique<ThreadArenas>();
+        for (size_t i = 0; i < frameCount; ++i) arenas->frames.emplace_back(blockBytes);
+        cache.push_back({id, arenas.get(), alive});
+        threads.push_back(std::move(arenas));
+        return threads.back()->frames[frame.load() % frameCount];
+    }
+
+    // Total semua thread untuk frame aktif
+    size_t bytesUsed() {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t used = 0;
+        for (auto& t : threads) used += t->frames[frame.load() % frameCount].bytesUsed();
+        return used;
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t total = 0;
+        for (auto& t : threads) {
+            for (const LinearArena& a : t->frames) total += a.capacity();
+        }
+        return total;
+    }
+};
+
+// =================================================================
+// 7. SHADER & RENDERING PIPELINE (CRTP Pattern)
+// =================================================================
+
+template <typename DerivedShader>
+class ShaderBase {
+public:
+    void execute() {
+        static_cast<DerivedShader*>(this)->apply_impl();
+    }
+};
+
+class PhongShader : public ShaderBase<PhongShader> {
+public:
+    void apply_impl() {
+        // Simulasi perhitungan pencahayaan Ambient, Diffuse, Specular
+        std::cout << "[Shader] Applying Phong Lighting Model..." << std::endl;
+    }
+};
+
+// =================================================================
+// 8. POST-PROCESSING (CPU Framebuffer)
+// =================================================================
+
+// HDR framebuffer disimpan per-channel (planar) supaya 8 pixel muat dalam satu register AVX2
+struct Framebuffer {
+    int width = 0, height = 0;
+    std::vector<float> r, g, b;
+
+    Framebuffer(int w = 0, int h = 0) { resize(w, h); }
+
+    void resize(int w, int h) {
+        width = w;
+        height = h;
+        r.assign(size_t(w) * h, 0.0f);
+        g.assign(size_t(w) * h, 0.0f);
+        b.assign(size_t(w) * h, 0.0f);
+    }
+
+    size_t pixelCount() const { return size_t(width) * height; }
+};
+
+struct PostProcessSettings {
+    float exposure = 1.0f;
+    float bloomThreshold = 1.0f;
+    float bloomIntensity = 0.15f;
+    float fxaaEdgeThreshold = 0.125f;
+    float fxaaEdgeThresholdMin = 0.0312f;
+    float fxaaSubpixel = 0.75f;
+};
+
+struct PostProcessTimings {
+    double bloomExtractMs = 0, bloomBlurMs = 0, tonemapMs = 0, fxaaMs = 0;
+    double totalMs() const { return bloomExtractMs + bloomBlurMs + tonemapMs + fxaaMs; }
+};
+
+namespace PostFx {
+    constexpr int kTileRows = 16;
+    constexpr float kBlurWeights[5] = {0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f};
+
+    // ACES filmic fit (Narkowicz) - hanya mul/add/div, jadi mudah divektorisasi
+    inline float aces(float x) {
+        return std::min(1.0f, std::max(0.0f, (x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f)));
+    }
+
+    // Linear -> sRGB approximation with three square roots instead of pow()
+    inline float toSrgb(float x) {
+        float s1 = std::sqrt(x), s2 = std::sqrt(s1), s3 = std::sqrt(s2);
+        return 0.585122381f * s1 + 0.783140355f * s2 - 0.368262736f * s3;
+    }
+
+    inline float luma(float r, float g, float b) { return 0.299f * r + 0.587f * g + 0.114f * b; }
+
+    inline uint32_t packRgba8(float r, float g, float b) {
+        auto q = [](float v) { return uint32_t(std::min(1.0f, std::max(0.0f, v)) * 255.0f + 0.5f); };
+        return q(r) | (q(g) << 8) | (q(b) << 16) | 0xFF000000u;
+    }
+
+#if defined(__AVX2__)
+    inline __m256 aces8(__m256 x) {
+        __m256 num = _mm256_mul_ps(x, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.51f), x), _mm256_set1_ps(0.03f)));
+        __m256 den = _mm256_add_ps(_mm256_mul_ps(x, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.43f), x), _mm256_set1_ps(0.59f))), _mm256_set1_ps(0.14f));
+        return _mm256_min_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(_mm256_setzero_ps(), _mm256_div_ps(num, den)));
+    }
+
+    inline __m256 toSrgb8(__m256 x) {
+        __m256 s1 = _mm256_sqrt_ps(x), s2 = _mm256_sqrt_ps(s1), s3 = _mm256_sqrt_ps(s2);
+        return _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.585122381f), s1),
+                                           _mm256_mul_ps(_mm256_set1_ps(0.783140355f), s2)),
+                             _mm256_mul_ps(_mm256_set1_ps(0.368262736f), s3));
+    }
+
+    inline __m256 luma8(__m256 r, __m256 g, __m256 b) {
+        return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.299f), r), _mm256_mul_ps(_mm256_set1_ps(0.587f), g)),
+                             _mm256_mul_ps(_mm256_set1_ps(0.114f), b));
+    }
+
+    // Jumlah pasangan berurutan dari 16 float -> 8 float (downsample horizontal 2x)
+    inline __m256 pairSum8(const float* p) {
+        __m256 s = _mm256_hadd_ps(_mm256_loadu_ps(p), _mm256_loadu_ps(p + 8));
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(s), 0xD8));
+    }
+
+    // Duplikasi 4 float -> 8 float (upsample horizontal 2x, nearest)
+    inline __m256 dup8(const float* p) {
+        __m128 v = _mm_loadu_ps(p);
+        return _mm256_set_m128(_mm_unpackhi_ps(v, v), _mm_unpacklo_ps(v, v));
+    }
+
+    inline __m256 abs8(__m256 v) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v); }
+
+    inline __m256 clamp01(__m256 v) { return _mm256_min_ps(_mm256_set1_ps(1.0f), _mm256_max_ps(_mm256_setzero_ps(), v)); }
+#endif
+}
+
+class PostProcessChain {
+private:
+    PostProcessSettings settings;
+    WorkerPool& pool;
+    Framebuffer bloomA, bloomB;     // half resolution
+    Framebuffer ldr;                // tonemapped, gamma-encoded
+    std::vector<float> lumaPlane;
+
+    template <typename RowFn>
+    double runRows(int rows, RowFn&& rowFn) {
+        auto start = std::chrono::steady_clock::now();
+        pool.parallelFor(size_t(rows), PostFx::kTileRows, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) rowFn(int(y));
+        });
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void extractBloomRow(const Framebuffer& hdr, int hy) {
+        const int hw = bloomA.width;
+        const size_t src0 = size_t(2 * hy) * hdr.width;
+        const size_t src1 = src0 + hdr.width;
+        const size_t dst = size_t(hy) * hw;
+        const float scale = 0.25f * settings.exposure;
+        const float threshold = settings.bloomThreshold;
+        int hx = 0;
+#if defined(__AVX2__)
+        const __m256 vScale = _mm256_set1_ps(scale), vThreshold = _mm256_set1_ps(threshold), zero = _mm256_setzero_ps();
+        const float* srcPlanes[3] = {hdr.r.data(), hdr.g.data(), hdr.b.data()};
+        float* dstPlanes[3] = {bloomA.r.data(), bloomA.g.data(), bloomA.b.data()};
+        for (; hx + 8 <= hw; hx += 8) {
+            for (int c = 0; c < 3; ++c) {
+                const float* p = srcPlanes[c];
+                __m256 sum = _mm256_add_ps(PostFx::pairSum8(p + src0 + 2 * hx), PostFx::pairSum8(p + src1 + 2 * hx));
+                __m256 bright = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_mul_ps(sum, vScale), vThreshold));
+                _mm256_storeu_ps(dstPlanes[c] + dst + hx, bright);
+            }
+        }
+#endif
+        for (; hx < hw; ++hx) {
+            size_t a = src0 + 2 * hx, b = src1 + 2 * hx;
+            bloomA.r[dst + hx] = std::max(0.0f, ((hdr.r[a] + hdr.r[a + 1]) + (hdr.r[b] + hdr.r[b + 1])) * scale - threshold);
+            bloomA.g[dst + hx] = std::max(0.0f, ((hdr.g[a] + hdr.g[a + 1]) + (hdr.g[b] + hdr.g[b + 1])) * scale - threshold);
+            bloomA.b[dst + hx] = std::max(0.0f, ((hdr.b[a] + hdr.b[a + 1]) + (hdr.b[b] + hdr.b[b + 1])) * scale - threshold);
+        }
+    }
+
+    // 9-tap separable gaussian; step = 1 untuk horizontal, width untuk vertikal
+    static void blurRow(const Framebuffer& src, Framebuffer& dst, int y, bool horizontal) {
+        const int w = src.width, h = src.height;
+        const size_t row = size_t(y) * w;
+        auto tap = [&](const std::vector<float>& plane, int x, int k) {
+            if (horizontal) return plane[row + std::min(w - 1, std::max(0, x + k))];
+            return plane[size_t(std::min(h - 1, std::max(0, y + k))) * w + x];
+        };
+        auto scalarPixel = [&](int x) {
+            for (int c = 0; c < 3; ++c) {
+                const auto& plane = c == 0 ? src.r : c == 1 ? src.g : src.b;
+                float acc = plane[row + x] * PostFx::kBlurWeights[0];
+                for (int k = 1; k < 5; ++k) acc += (tap(plane, x, -k) + tap(plane, x, k)) * PostFx::kBlurWeights[k];
+                (c == 0 ? dst.r : c == 1 ? dst.g : dst.b)[row + x] = acc;
+            }
+        };
+
+        int x = 0;
+#if defined(__AVX2__)
+        const std::vector<float>* srcPlanes[3] = {&src.r, &src.g, &src.b};
+        std::vector<float>* dstPlanes[3] = {&dst.r, &dst.g, &dst.b};
+        if (horizontal) {
+            for (; x < std::min(4, w); ++x) scalarPixel(x);
+            for (; x + 8 <= w - 4; x += 8) {
+                for (int c = 0; c < 3; ++c) {
+                    const float* p = srcPlanes[c]->data() + row + x;
+                    __m256 acc = _mm256_mul_ps(_mm256_loadu_ps(p), _mm256_set1_ps(PostFx::kBlurWeights[0]));
+                    for (int k = 1; k < 5; ++k) {
+                        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(p - k), _mm256_loadu_ps(p + k)),
+                                                               _mm256_set1_ps(PostFx::kBlurWeights[k])));
+                    }
+                    _mm256_storeu_ps(dstPlanes[c]->data() + row + x, acc);
+                }
+            }
+        } else {
+            const float* rows[9];
+            for (; x + 8 <= w; x += 8) {
+                for (int c = 0; c < 3; ++c) {
+                    for (int k = -4; k <= 4; ++k) {
+                        rows[k + 4] = srcPlanes[c]->data() + size_t(std::min(h - 1, std::max(0, y + k))) * w + x;
+                    }
+                    __m256 acc = _mm256_mul_ps(_mm256_loadu_ps(rows[4]), _mm256_set1_ps(PostFx::kBlurWeights[0]));
+                    for (int k = 1; k < 5; ++k) {
+                        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(rows[4 - k]), _mm256_loadu_ps(rows[4 + k])),
+                                                               _mm256_set1_ps(PostFx::kBlurWeights[k])));
+                    }
+                    _mm256_storeu_ps(dstPlanes[c]->data() + row + x, acc);
+                }
+            }
+        }
+#endif
+        for (; x < w; ++x) scalarPixel(x);
+    }
+
+    // Fused pass: bloom composite + exposure + ACES + sRGB + luma, satu kali baca/tulis per pixel
+    void tonemapRow(const Framebuffer& hdr, int y) {
+        const int w = hdr.width;
+        const size_t row = size_t(y) * w;
+        const size_t bloomRow = size_t(std::min(y / 2, bloomA.height - 1)) * bloomA.width;
+        const float exposure = settings.exposure, intensity = settings.bloomIntensity;
+        int x = 0;
+#if defined(__AVX2__)
+        const __m256 vExposure = _mm256_set1_ps(exposure), vIntensity = _mm256_set1_ps(intensity);
+        const int vecEnd = std::min(w, 2 * bloomA.width) & ~7;
+        for (; x < vecEnd; x += 8) {
+            __m256 rgb[3];
+            const float* srcPlanes[3] = {hdr.r.data(), hdr.g.data(), hdr.b.data()};
+            const float* bloomPlanes[3] = {bloomA.r.data(), bloomA.g.data(), bloomA.b.data()};
+            float* dstPlanes[3] = {ldr.r.data(), ldr.g.data(), ldr.b.data()};
+            for (int c = 0; c < 3; ++c) {
+                __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(srcPlanes[c] + row + x), vExposure),
+                                         _mm256_mul_ps(PostFx::dup8(bloomPlanes[c] + bloomRow + x / 2), vIntensity));
+                rgb[c] = PostFx::toSrgb8(PostFx::aces8(v));
+                _mm256_storeu_ps(dstPlanes[c] + row + x, rgb[c]);
+            }
+            _mm256_storeu_ps(lumaPlane.data() + row + x, PostFx::luma8(rgb[0], rgb[1], rgb[2]));
+        }
+#endif
+        for (; x < w; ++x) {
+            size_t bi = bloomRow + std::min(x / 2, bloomA.width - 1);
+            float r = PostFx::toSrgb(PostFx::aces(hdr.r[row + x] * exposure + bloomA.r[bi] * intensity));
+            float g = PostFx::toSrgb(PostFx::aces(hdr.g[row + x] * exposure + bloomA.g[bi] * intensity));
+            float b = PostFx::toSrgb(PostFx::aces(hdr.b[row + x] * exposure + bloomA.b[bi] * intensity));
+            ldr.r[row + x] = r;
+            ldr.g[row + x] = g;
+            ldr.b[row + x] = b;
+            lumaPlane[row + x] = PostFx::luma(r, g, b);
+        }
+    }
+
+    // FXAA-style: deteksi tepi dari kontras luma, lalu blend ke tetangga tegak lurus tepi
+    void fxaaPixel(int x, int y, uint32_t* out) const {
+        const int w = ldr.width;
+        const size_t i = size_t(y) * w + x;
+        if (x == 0 || y == 0 || x == w - 1 || y == ldr.height - 1) {
+            out[i] = PostFx::packRgba8(ldr.r[i], ldr.g[i], ldr.b[i]);
+            return;
+        }
+        float c = lumaPlane[i], n = lumaPlane[i - w], s = lumaPlane[i + w], wl = lumaPlane[i - 1], e = lumaPlane[i + 1];
+        float mx = std::max({c, n, s, wl, e}), mn = std::min({c, n, s, wl, e});
+        float range = mx - mn;
+        if (range < std::max(settings.fxaaEdgeThresholdMin, mx * settings.fxaaEdgeThreshold)) {
+            out[i] = PostFx::packRgba8(ldr.r[i], ldr.g[i], ldr.b[i]);
+            return;
+        }
+        bool horizontalEdge = std::abs(n + s - 2 * c) >= std::abs(wl + e - 2 * c);
+        size_t nb = horizontalEdge ? (std::abs(n - c) >= std::abs(s - c) ? i - w : i + w)
+                                   : (std::abs(wl - c) >= std::abs(e - c) ? i - 1 : i + 1);
+        float sub = std::min(1.0f, std::abs(((n + s) + (wl + e)) * 0.25f - c) / range); // asosiasi sama dengan fxaaRow AVX2
+        float blend = sub * sub * settings.fxaaSubpixel;
+        out[i] = PostFx::packRgba8(ldr.r[i] + (ldr.r[nb] - ldr.r[i]) * blend,
+                                   ldr.g[i] + (ldr.g[nb] - ldr.g[i]) * blend,
+                                   ldr.b[i] + (ldr.b[nb] - ldr.b[i]) * blend);
+    }
+
+    void fxaaRow(int y, uint32_t* out) const {
+        const int w = ldr.width;
+        int x = 0;
+#if defined(__AVX2__)
+        if (y > 0 && y < ldr.height - 1) {
+            fxaaPixel(0, y, out);
+            x = 1;
+            const size_t row = size_t(y) * w;
+            const float* L = lumaPlane.data();
+            const __m256 edgeMin = _mm256_set1_ps(settings.fxaaEdgeThresholdMin), edgeRel = _mm256_set1_ps(settings.fxaaEdgeThreshold);
+            const __m256 two = _mm256_set1_ps(2.0f), quarter = _mm256_set1_ps(0.25f), one = _mm256_set1_ps(1.0f);
+            const __m256 subpix = _mm256_set1_ps(settings.fxaaSubpixel), scale255 = _mm256_set1_ps(255.0f), half = _mm256_set1_ps(0.5f);
+            for (; x + 8 <= w - 1; x += 8) {
+                size_t i = row + x;
+                __m256 c = _mm256_loadu_ps(L + i), n = _mm256_loadu_ps(L + i - w), s = _mm256_loadu_ps(L + i + w);
+                __m256 wl = _mm256_loadu_ps(L + i - 1), e = _mm256_loadu_ps(L + i + 1);
+                __m256 mx = _mm256_max_ps(_mm256_max_ps(_mm256_max_ps(c, n), _mm256_max_ps(s, wl)), e);
+                __m256 mn = _mm256_min_ps(_mm256_min_ps(_mm256_min_ps(c, n), _mm256_min_ps(s, wl)), e);
+                __m256 range = _mm256_sub_ps(mx, mn);
+                __m256 isEdge = _mm256_cmp_ps(range, _mm256_max_ps(edgeMin, _mm256_mul_ps(mx, edgeRel)), _CMP_GE_OQ);
+
+                __m256 c2 = _mm256_mul_ps(c, two);
+                __m256 horizontalEdge = _mm256_cmp_ps(PostFx::abs8(_mm256_sub_ps(_mm256_add_ps(n, s), c2)),
+                                                      PostFx::abs8(_mm256_sub_ps(_mm256_add_ps(wl, e), c2)), _CMP_GE_OQ);
+                __m256 pickN = _mm256_cmp_ps(PostFx::abs8(_mm256_sub_ps(n, c)), PostFx::abs8(_mm256_sub_ps(s, c)), _CMP_GE_OQ);
+                __m256 pickW = _mm256_cmp_ps(PostFx::abs8(_mm256_sub_ps(wl, c)), PostFx::abs8(_mm256_sub_ps(e, c)), _CMP_GE_OQ);
+
+                __m256 avg = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n, s), _mm256_add_ps(wl, e)), quarter);
+                __m256 sub = _mm256_min_ps(one, _mm256_div_ps(PostFx::abs8(_mm256_sub_ps(avg, c)), _mm256_max_ps(range, _mm256_set1_ps(1e-6f))));
+                __m256 blend = _mm256_and_ps(isEdge, _mm256_mul_ps(_mm256_mul_ps(sub, sub), subpix));
+
+                __m256i packed = _mm256_set1_epi32(int(0xFF000000u));
+                const float* planes[3] = {ldr.r.data(), ldr.g.data(), ldr.b.data()};
+                for (int ch = 0; ch < 3; ++ch) {
+                    const float* p = planes[ch];
+                    __m256 center = _mm256_loadu_ps(p + i);
+                    __m256 vert = _mm256_blendv_ps(_mm256_loadu_ps(p + i + w), _mm256_loadu_ps(p + i - w), pickN);
+                    __m256 horz = _mm256_blendv_ps(_mm256_loadu_ps(p + i + 1), _mm256_loadu_ps(p + i - 1), pickW);
+                    __m256 nb = _mm256_blendv_ps(horz, vert, horizontalEdge);
+                    __m256 v = PostFx::clamp01(_mm256_add_ps(center, _mm256_mul_ps(_mm256_sub_ps(nb, center), blend)));
+                    __m256i q = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, scale255), half));
+                    packed = _mm256_or_si256(packed, _mm256_slli_epi32(q, 8 * ch));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+            }
+        }
+#endif
+        for (; x < w; ++x) fxaaPixel(x, y, out);
+    }
+
+public:
+    explicit PostProcessChain(PostProcessSettings s = {}, WorkerPool& p = WorkerPool::getInstance())
+        : settings(s), pool(p) {}
+
+    PostProcessSettings& getSettings() { return settings; }
+
+    // HDR -> RGBA8. Urutan pass: bloom extract -> blur H/V -> (composite+tonemap+gamma+luma) -> FXAA+pack
+    PostProcessTimings apply(const Framebuffer& hdr, std::vector<uint32_t>& out) {
+        if (ldr.width != hdr.width || ldr.height != hdr.height) {
+            ldr.resize(hdr.width, hdr.height);
+            lumaPlane.assign(hdr.pixelCount(), 0.0f);
+            bloomA.resize(std::max(1, hdr.width / 2), std::max(1, hdr.height / 2));
+            bloomB.resize(bloomA.width, bloomA.height);
+        }
+        out.resize(hdr.pixelCount());
+
+        PostProcessTimings t;
+        if (hdr.width < 2 || hdr.height < 2) {
+            for (size_t i = 0; i < hdr.pixelCount(); ++i) out[i] = PostFx::packRgba8(hdr.r[i], hdr.g[i], hdr.b[i]);
+            return t;
+        }
+        t.bloomExtractMs = runRows(bloomA.height, [&](int y) { extractBloomRow(hdr, y); });
+        t.bloomBlurMs = runRows(bloomA.height, [&](int y) { blurRow(bloomA, bloomB, y, true); });
+        t.bloomBlurMs += runRows(bloomA.height, [&](int y) { blurRow(bloomB, bloomA, y, false); });
+        t.tonemapMs = runRows(hdr.height, [&](int y) { tonemapRow(hdr, y); });
+        t.fxaaMs = runRows(hdr.height, [&](int y) { fxaaRow(y, out.data()); });
+        return t;
+    }
+};
+
+// =================================================================
+// 9. COMPONENT TYPE REGISTRY
+// =================================================================
+
+using ComponentTypeId = uint32_t;
+constexpr size_t kMaxComponentTypes = 64;
+constexpr size_t kChunkAlignment = 64;
+using ComponentMask = std::bitset<kMaxComponentTypes>;
+
+// Tipe yang boleh dipindah dengan memcpy, lalu sumbernya dianggap memori mentah (tanpa move ctor + dtor).
+// Default: trivially copyable. Tipe non-polimorfik tanpa pointer ke dirinya sendiri bisa opt-in lewat spesialisasi;
+// tipe polimorfik (vptr) tidak boleh, objeknya hanya boleh dibuat lewat constructor.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Tipe yang salinannya boleh dibuat dengan memcpy (Prefab mengisi kolom dengan memcpy berlipat).
+// Default: trivially copyable; opt-in dengan aturan yang sama seperti di atas.
+template <typename T>
+struct is_bitwise_copyable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+constexpr bool is_bitwise_copyable_v = is_bitwise_copyable<T>::value;
+
+// Nama tipe tanpa RTTI, diambil dari signature fungsi; dipakai sebagai kunci stabil di file snapshot
+template <typename T>
+std::string_view componentTypeName() {
+#if defined(__clang__) || defined(__GNUC__)
+    std::string_view signature = __PRETTY_FUNCTION__; // "... [with T = TransformComponent; ...]" / "[T = TransformComponent]"
+    size_t begin = signature.find("T = ") + 4;
+    return signature.substr(begin, signature.find_first_of(";]", begin) - begin);
+#elif defined(_MSC_VER)
+    std::string_view signature = __FUNCSIG__; // "... componentTypeName<struct TransformComponent>(void)"
+    size_t begin = signature.find("componentTypeName<") + 18;
+    return signature.substr(begin, signature.rfind(">(") - begin);
+#else
+    return "unnamed";
+#endif
+}
+
+// Stream byte sederhana untuk snapshot; pembacaan memeriksa batas supaya file terpotong tidak dibaca liar
+class ByteWriter {
+private:
+    std::string& out;
+
+public:
+    explicit ByteWriter(std::string& buffer) : out(buffer) {}
+
+    template <typename T>
+    void pod(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "pod() hanya untuk tipe trivially copyable");
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void bytes(const void* data, size_t size) { out.append(static_cast<const char*>(data), size); }
+
+    void string(std::string_view text) {
+        pod(uint32_t(text.size()));
+        out.append(text.data(), text.size());
+    }
+
+    size_t size() const { return out.size(); }
+};
+
+class ByteReader {
+private:
+    const char* cursor;
+    const char* end;
+
+public:
+    ByteReader(const void* data, size_t size) : cursor(static_cast<const char*>(data)), end(cursor + size) {}
+
+    const char* take(size_t size) {
+        if (size_t(end - cursor) < size) throw std::runtime_error("Truncated snapshot");
+        const char* at = cursor;
+        cursor += size;
+        return at;
+    }
+
+    template <typename T>
+    T pod() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    // Panjang dicek terhadap sisa buffer sebelum alokasi, supaya count rusak tidak minta memori gila-gilaan
+    template <typename T>
+    void podArray(std::vector<T>& out, size_t count) {
+        if (count > size_t(end - cursor) / sizeof(T)) throw std::runtime_error("Truncated snapshot");
+        out.resize(count);
+        if (count != 0) std::memcpy(out.data(), take(count * sizeof(T)), count * sizeof(T));
+    }
+
+    std::string string() {
+        uint32_t size = pod<uint32_t>();
+        return std::string(take(size), size);
+    }
+};
+
+// Komponen yang tidak trivially relocatable (punya pointer ke heap atau vptr) masuk snapshot lewat spesialisasi ini:
+//   static void write(const T&, ByteWriter&);  static void read(void* dst, ByteReader&); // placement-new ke dst
+template <typename T>
+struct ComponentSerializer;
+
+template <typename T, typename = void>
+struct HasComponentSerializer : std::false_type {};
+
+template <typename T>
+struct HasComponentSerializer<T, std::void_t<decltype(sizeof(ComponentSerializer<T>))>> : std::true_type {};
+
+// Metadata per tipe; storage generik hanya bekerja dengan byte + thunk ini, tanpa RTTI atau virtual
+struct ComponentInfo {
+    ComponentTypeId id = 0;
+    std::string_view name;
+    size_t size = 0;
+    size_t alignment = 1;
+    bool triviallyRelocatable = false;
+    bool bitwiseCopyable = false;
+    bool triviallyDestructible = false;
+    void (*moveConstruct)(void* dst, void* src) = nullptr;
+    void (*copyConstruct)(void* dst, const void* src) = nullptr; // nullptr jika tipe tidak bisa di-copy
+    void (*destroy)(void* p) = nullptr;
+    void (*serialize)(const void* p, ByteWriter& out) = nullptr; // hanya untuk tipe dengan ComponentSerializer
+    void (*deserialize)(void* dst, ByteReader& in) = nullptr;
+
+    // Setelah relocate, src adalah memori mentah dan tidak boleh di-destroy lagi
+    void relocate(void* dst, void* src) const {
+        if (triviallyRelocatable) {
+            std::memcpy(dst, src, size);
+        } else {
+            moveConstruct(dst, src);
+            destroy(src);
+        }
+    }
+
+    void destroyAt(void* p) const {
+        if (!triviallyDestructible) destroy(p);
+    }
+};
+
+class ComponentRegistry {
+private:
+    // Array tetap (bukan vector) supaya info(id) aman dibaca thread lain selagi tipe baru didaftarkan
+    std::array<ComponentInfo, kMaxComponentTypes> infos{};
+    std::atomic<ComponentTypeId> registered{0}; // dipublikasikan (release) setelah infos[id] terisi
+    std::mutex registerMtx;                     // tipe berbeda bisa didaftarkan dari thread berbeda
+
+    ComponentRegistry() = default;
+
+public:
+    static ComponentRegistry& getInstance() {
+        static ComponentRegistry instance;
+        return instance;
+    }
+
+    template <typename T>
+    ComponentTypeId registerType() {
+        static_assert(std::is_move_constructible_v<T>, "komponen harus move-constructible");
+        static_assert(alignof(T) <= kChunkAlignment, "alignment komponen melebihi alignment chunk");
+        static_assert(!std::is_polymorphic_v<T> || (!is_trivially_relocatable_v<T> && !is_bitwise_copyable_v<T>),
+                      "tipe polimorfik tidak boleh dipindah/disalin dengan memcpy");
+        std::lock_guard<std::mutex> lock(registerMtx);
+        const ComponentTypeId id = registered.load(std::memory_order_relaxed);
+        if (id >= kMaxComponentTypes) throw std::runtime_error("Too many component types");
+        ComponentInfo& info = infos[id];
+        info.id = id;
+        info.name = componentTypeName<T>();
+        info.size = sizeof(T);
+        info.alignment = alignof(T);
+        info.triviallyRelocatable = is_trivially_relocatable_v<T>;
+        info.bitwiseCopyable = is_bitwise_copyable_v<T>;
+        info.triviallyDestructible = std::is_trivially_destructible_v<T>;
+        info.moveConstruct = [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); };
+        if constexpr (std::is_copy_constructible_v<T>) {
+            info.copyConstruct = [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); };
+        }
+        info.destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+        if constexpr (HasComponentSerializer<T>::value) {
+            info.serialize = [](const void* p, ByteWriter& out) { ComponentSerializer<T>::write(*static_cast<const T*>(p), out); };
+            info.deserialize = [](void* dst, ByteReader& in) { ComponentSerializer<T>::read(dst, in); };
+        }
+        registered.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    const ComponentInfo& info(ComponentTypeId id) const { return infos[id]; }
+
+    // Hanya tipe yang sudah dipakai (terdaftar) di proses ini yang bisa ditemukan
+    const ComponentInfo* find(std::string_view name) const {
+        for (size_t i = 0; i < size(); ++i) {
+            if (infos[i].name == name) return &infos[i];
+        }
+        return nullptr;
+    }
+    size_t size() const { return registered.load(std::memory_order_acquire); }
+};
+
+// Id padat dibagikan saat tipe pertama kali dipakai. `const T` berbagi id dengan T;
+// constness hanya dipakai scheduler sebagai tanda akses read-only
+template <typename T>
+ComponentTypeId componentTypeId() {
+    if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+        return componentTypeId<std::remove_cv_t<T>>();
+    } else {
+        static const ComponentTypeId id = ComponentRegistry::getInstance().registerType<T>();
+        return id;
+    }
+}
+
+template <typename T>
+const ComponentInfo& componentInfo() {
+    return ComponentRegistry::getInstance().info(componentTypeId<T>());
+}
+
+template <typename... Ts>
+ComponentMask componentMask() {
+    ComponentMask mask;
+    (mask.set(componentTypeId<Ts>()), ...);
+    return mask;
+}
+
+// Daftarkan tipe sebelum dipakai pertama kali, mis. supaya ComponentRegistry::find mengenalnya saat load snapshot
+template <typename... Ts>
+void registerComponentTypes() {
+    (componentTypeId<Ts>(), ...);
+}
+
+// =================================================================
+// 10. ENTITY COMPONENT SYSTEM (ECS) CORE
+// =================================================================
+
+class Component {
+public:
+    virtual ~Component() = default;
+    virtual void update(double dt) = 0;
+};
+
+class TransformComponent final : public Component {
+public:
+    Engine::Math::Vector3 position;
+    Engine::Math::Vector3 rotation;
+    
+    TransformComponent(double x, double y, double z) : position(x, y, z) {}
+    
+    void update(double dt) override {
+        position.x += 0.01 * dt; // Simulasi pergerakan konstan
+    }
+};
+
+class MeshComponent final : public Component {
+public:
+    std::string modelPath;
+    int vertexCount;
+    double boundsRadius;
+
+    MeshComponent(std::string path, double radius = 1.0) : modelPath(path), vertexCount(1000), boundsRadius(radius) {}
+
+    void update(double dt) override {
+        // Render logic biasanya di sini
+    }
+};
+
+// read() membaca semua field dulu, baru placement-new: payload rusak tidak meninggalkan objek setengah jadi
+template <>
+struct ComponentSerializer<TransformComponent> {
+    static void write(const TransformComponent& t, ByteWriter& out) {
+        out.pod(t.position);
+        out.pod(t.rotation);
+    }
+
+    static void read(void* dst, ByteReader& in) {
+        const auto position = in.pod<Engine::Math::Vector3>();
+        const auto rotation = in.pod<Engine::Math::Vector3>();
+        auto* t = new (dst) TransformComponent(position.x, position.y, position.z);
+        t->rotation = rotation;
+    }
+};
+
+template <>
+struct ComponentSerializer<MeshComponent> {
+    static void write(const MeshComponent& mesh, ByteWriter& out) {
+        out.string(mesh.modelPath);
+        out.pod(mesh.vertexCount);
+        out.pod(mesh.boundsRadius);
+    }
+
+    static void read(void* dst, ByteReader& in) {
+        std::string path = in.string();
+        const int vertexCount = in.pod<int>();
+        const double boundsRadius = in.pod<double>();
+        auto* mesh = new (dst) MeshComponent(std::move(path), boundsRadius);
+        mesh->vertexCount = vertexCount;
+    }
+};
+
+// Slab per tipe komponen untuk Entity::addComponent: komponen satu tipe yang dibuat berurutan bersebelahan
+// di memori (stride = sizeof slot, bukan tersebar di heap bersama Entity, vector, dan string), dan
+// membuat/menghapusnya tidak lewat malloc. Slot bebas disimpan di free list intrusif (LIFO). Slab tidak pernah
+// dikembalikan ke heap, dan pool sengaja tidak dihancurkan supaya Entity yang hidup sampai static destruction
+// tetap aman.
+template <typename T>
+class ComponentPool {
+private:
+    static constexpr size_t kSlotAlign = std::max(alignof(T), alignof(void*));
+    static constexpr size_t kSlotBytes = (std::max(sizeof(T), sizeof(void*)) + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+    static constexpr size_t kSlabBytes = 64 * 1024;
+    static constexpr size_t kSlotsPerSlab = std::max<size_t>(kSlabBytes / kSlotBytes, 1);
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    std::mutex mtx; // Entity bisa dilepas dari thread mana pun (shared_ptr)
+    std::vector<std::byte*> slabs;
+    FreeSlot* freeList = nullptr;
+    std::byte* bump = nullptr;
+    size_t bumpLeft = 0;
+    size_t live = 0;
+
+    ComponentPool() = default;
+
+public:
+    static ComponentPool& instance() {
+        static ComponentPool* pool = new ComponentPool();
+        return *pool;
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++live;
+        if (freeList) return std::exchange(freeList, freeList->next);
+        if (bumpLeft == 0) {
+            bump = static_cast<std::byte*>(::operator new(kSlotsPerSlab * kSlotBytes, std::align_val_t(std::max(kSlotAlign, kChunkAlignment))));
+            slabs.push_back(bump);
+            bumpLeft = kSlotsPerSlab;
+        }
+        --bumpLeft;
+        return std::exchange(bump, bump + kSlotBytes);
+    }
+
+    void deallocate(void* slot) {
+        std::lock_guard<std::mutex> lock(mtx);
+        --live;
+        freeList = ::new (slot) FreeSlot{freeList};
+    }
+
+    size_t liveCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return live;
+    }
+
+    size_t capacity() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return slabs.size() * kSlotsPerSlab;
+    }
+};
+
+// Deleter menyimpan fungsi pelepas milik tipe dinamisnya, jadi unique_ptr<Component> tetap polimorfik
+struct PooledComponentDeleter {
+    void (*release)(Component*) = nullptr;
+
+    void operator()(Component* component) const { release(component); }
+};
+
+using PooledComponent = std::unique_ptr<Component, PooledComponentDeleter>;
+
+template <typename T, typename... Args>
+PooledComponent makePooledComponent(Args&&... args) {
+    ComponentPool<T>& pool = ComponentPool<T>::instance();
+    void* slot = pool.allocate();
+    T* component;
+    try {
+        component = ::new (slot) T(std::forward<Args>(args)...);
+    } catch (...) {
+        pool.deallocate(slot);
+        throw;
+    }
+    return PooledComponent(component, {[](Component* c) {
+        T* typed = static_cast<T*>(c);
+        typed->~T();
+        ComponentPool<T>::instance().deallocate(typed);
+    }});
+}
+
+class Entity {
+    size_t id;
+    std::vector<PooledComponent> components;
+    std::vector<ComponentTypeId> componentTypes; // sejajar dengan components, untuk lookup tanpa dynamic_cast
+
+public:
+    // Di dalam scene, buat lewat SceneManager::createEntity supaya id-nya unik
+    explicit Entity(size_t _id) : id(_id) {}
+
+    template <typename T, typename... Args>
+    void addComponent(Args&&... args) {
+        components.push_back(makePooledComponent<T>(std::forward<Args>(args)...));
+        componentTypes.push_back(componentTypeId<T>());
+    }
+
+    template <typename T>
+    T* getComponent() const {
+        const ComponentTypeId type = componentTypeId<T>();
+        for (size_t i = 0; i < components.size(); ++i) {
+            if (componentTypes[i] == type) return static_cast<T*>(components[i].get());
+        }
+        return nullptr;
+    }
+
+    void update(double dt) {
+        for (auto& comp : components) comp->update(dt);
+    }
+    
+    size_t getId() const { return id; }
+};
+
+// =================================================================
+// 11. ARCHETYPE STORAGE (Chunked Component Tables)
+// =================================================================
+
+using EntityId = uint32_t; // indeks slot entity; handle lengkap (dengan generation) ada di ECS WORLD
+
+// Blok dari snapshot yang di-mmap tidak dimiliki chunk (owned = false); file-nya dijaga hidup oleh world
+struct ChunkBlockDeleter {
+    bool owned = true;
+    void operator()(std::byte* p) const {
+        if (owned) ::operator delete(p, std::align_val_t(kChunkAlignment));
+    }
+};
+
+// Satu blok memori per chunk berisi semua kolom (SoA); offset tiap kolom ditentukan Archetype
+struct ArchetypeChunk {
+    std::unique_ptr<std::byte, ChunkBlockDeleter> block;
+    std::vector<EntityId> entities;
+    std::vector<uint32_t> rowTicks;    // [kolom * kapasitas + baris]: tick terakhir komponen ditambah/ditulis
+    std::vector<uint32_t> columnTicks; // tick maksimum per kolom, supaya chunk tanpa perubahan dilewati utuh
+    std::vector<uint32_t> wholeColumnTicks; // tick terakhir seluruh kolom ditulis (`each` non-const), tanpa mengisi rowTicks
+    uint32_t structureTick = 0;             // tick terakhir baris ditambah, dihapus, atau diisi baris pindahan
+};
+
+class Archetype {
+public:
+    static constexpr size_t kChunkBytes = 16 * 1024;
+
+    ComponentMask mask;
+    std::vector<ComponentTypeId> types;         // terurut naik
+    std::vector<const ComponentInfo*> infos;    // sejajar dengan types
+    std::vector<size_t> columnOffsets;          // offset kolom di dalam blok chunk
+    std::array<int8_t, kMaxComponentTypes> columnOf; // ComponentTypeId -> indeks kolom, -1 jika tidak ada
+    std::vector<ArchetypeChunk> chunks;
+    size_t chunkCapacity = 1;
+    size_t blockBytes = kChunkBytes;
+    bool triviallyDestructible = true;
+
+    // Kolom diturunkan langsung dari bit mask + metadata registry, jadi archetype baru tidak butuh prototipe bertipe
+    explicit Archetype(const ComponentMask& m) : mask(m) {
+        columnOf.fill(-1);
+        size_t rowBytes = sizeof(EntityId);
+        for (ComponentTypeId type = 0; type < kMaxComponentTypes; ++type) {
+            if (!m.test(type)) continue;
+            const ComponentInfo& info = ComponentRegistry::getInstance().info(type);
+            columnOf[type] = int8_t(types.size());
+            types.push_back(type);
+            infos.push_back(&info);
+            rowBytes += info.size;
+            triviallyDestructible &= info.triviallyDestructible;
+        }
+        chunkCapacity = std::max<size_t>(1, kChunkBytes / rowBytes);
+        // Padding alignment antar kolom bisa membuat kapasitas awal sedikit melebihi blok
+        while (layoutColumns(chunkCapacity) > kChunkBytes && chunkCapacity > 1) --chunkCapacity;
+        blockBytes = std::max(kChunkBytes, layoutColumns(chunkCapacity));
+    }
+
+    ~Archetype() {
+        if (triviallyDestructible) return;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            for (size_t row = 0; row < chunks[c].entities.size(); ++row) destroyRow(c, row);
+        }
+    }
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    int columnIndex(ComponentTypeId type) const { return type < kMaxComponentTypes ? columnOf[type] : -1; }
+
+    void* cell(size_t chunk, size_t column, size_t row) {
+        return chunks[chunk].block.get() + columnOffsets[column] + row * infos[column]->size;
+    }
+
+    ArchetypeChunk& appendChunk() {
+        ArchetypeChunk chunk;
+        chunk.block.reset(static_cast<std::byte*>(::operator new(blockBytes, std::align_val_t(kChunkAlignment))));
+        chunk.entities.reserve(chunkCapacity);
+        chunk.rowTicks.assign(infos.size() * chunkCapacity, 0);
+        chunk.columnTicks.assign(infos.size(), 0);
+        chunk.wholeColumnTicks.assign(infos.size(), 0);
+        chunks.push_back(std::move(chunk));
+        return chunks.back();
+    }
+
+    // Chunk terakhir yang masih punya slot; buat baru jika penuh
+    size_t chunkWithSpace() {
+        if (chunks.empty() || chunks.back().entities.size() == chunkCapacity) appendChunk();
+        return chunks.size() - 1;
+    }
+
+    template <typename T>
+    T* columnData(size_t chunk) {
+        int col = columnOf[componentTypeId<T>()];
+        return reinterpret_cast<T*>(chunks[chunk].block.get() + columnOffsets[col]);
+    }
+
+    uint32_t* rowTicks(size_t chunk, size_t column) { return chunks[chunk].rowTicks.data() + column * chunkCapacity; }
+
+    uint32_t rowTick(size_t chunk, size_t column, size_t row) {
+        return std::max(rowTicks(chunk, column)[row], chunks[chunk].wholeColumnTicks[column]);
+    }
+
+    void stampRow(size_t chunk, size_t column, size_t row, uint32_t tick) {
+        rowTicks(chunk, column)[row] = tick;
+        uint32_t& max = chunks[chunk].columnTicks[column];
+        max = std::max(max, tick);
+    }
+
+    // Dipakai iterasi `each` dengan akses tulis: semua baris chunk dianggap berubah. Baris yang nanti
+    // dipindah masuk ke chunk ini ikut terlihat berubah; konservatif, tidak pernah melewatkan perubahan.
+    void stampColumn(size_t chunk, size_t column, uint32_t tick) {
+        uint32_t& whole = chunks[chunk].wholeColumnTicks[column];
+        whole = std::max(whole, tick);
+        uint32_t& max = chunks[chunk].columnTicks[column];
+        max = std::max(max, tick);
+    }
+
+    void destroyRow(size_t chunk, size_t row) {
+        if (triviallyDestructible) return;
+        for (size_t c = 0; c < infos.size(); ++c) infos[c]->destroyAt(cell(chunk, c, row));
+    }
+
+    size_t entityCount() const {
+        size_t n = 0;
+        for (auto& c : chunks) n += c.entities.size();
+        return n;
+    }
+
+private:
+    size_t layoutColumns(size_t capacity) {
+        columnOffsets.clear();
+        size_t offset = 0;
+        for (const ComponentInfo* info : infos) {
+            offset = (offset + info->alignment - 1) / info->alignment * info->alignment;
+            columnOffsets.push_back(offset);
+            offset += info->size * capacity;
+        }
+        return offset;
+    }
+};
+
+// =================================================================
+// 12. SPARSE-SET COMPONENT POOLS
+// =================================================================
+
+// Komponen yang sering ditambah/dihapus (status effect, tag gameplay) bisa memilih storage sparse:
+//   struct Stunned { static constexpr StorageKind storage = StorageKind::Sparse; float remaining; };
+enum class StorageKind { Table, Sparse };
+
+template <typename T, typename = void>
+struct ComponentStorage {
+    static constexpr StorageKind kind = StorageKind::Table;
+};
+
+template <typename T>
+struct ComponentStorage<T, std::void_t<decltype(T::storage)>> {
+    static constexpr StorageKind kind = T::storage;
+};
+
+template <typename T>
+constexpr bool isSparseComponent = ComponentStorage<T>::kind == StorageKind::Sparse;
+
+class SparseSetBase {
+public:
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+    static constexpr size_t kPageSize = 4096;
+
+    virtual ~SparseSetBase() = default;
+    virtual void remove(EntityId id) = 0;
+
+    bool contains(EntityId id) const { return denseIndex(id) != kInvalid; }
+    size_t size() const { return dense.size(); }
+    const std::vector<EntityId>& entities() const { return dense; }
+
+protected:
+    std::vector<std::unique_ptr<uint32_t[]>> pages; // sparse: EntityId -> index dense, dipaging supaya id besar tidak boros
+    std::vector<EntityId> dense;
+
+    uint32_t denseIndex(EntityId id) const {
+        size_t page = id / kPageSize;
+        if (page >= pages.size() || !pages[page]) return kInvalid;
+        return pages[page][id % kPageSize];
+    }
+
+    uint32_t& slot(EntityId id) {
+        size_t page = id / kPageSize;
+        if (page >= pages.size()) pages.resize(page + 1);
+        if (!pages[page]) {
+            pages[page] = std::make_unique<uint32_t[]>(kPageSize);
+            std::fill_n(pages[page].get(), kPageSize, kInvalid);
+        }
+        return pages[page][id % kPageSize];
+    }
+};
+
+// Dense array ter-pack: add/remove O(1) (swap dengan elemen terakhir), iterasi linear tanpa lubang
+template <typename T>
+class SparseSet final : public SparseSetBase {
+private:
+    std::vector<T> values;
+
+public:
+    template <typename... Args>
+    T& emplace(EntityId id, Args&&... args) {
+        uint32_t& index = slot(id);
+        if (index != kInvalid) {
+            values[index] = T{std::forward<Args>(args)...};
+            return values[index];
+        }
+        index = uint32_t(dense.size());
+        dense.push_back(id);
+        values.push_back(T{std::forward<Args>(args)...});
+        return values.back();
+    }
+
+    void remove(EntityId id) override {
+        uint32_t index = denseIndex(id);
+        if (index == kInvalid) return;
+        if (index != dense.size() - 1) { // elemen terakhir: tidak ada yang dipindah (hindari self-move)
+            EntityId last = dense.back();
+            dense[index] = last;
+            values[index] = std::move(values.back());
+            slot(last) = index;
+        }
+        slot(id) = kInvalid;
+        dense.pop_back();
+        values.pop_back();
+    }
+
+    T* get(EntityId id) {
+        uint32_t index = denseIndex(id);
+        return index == kInvalid ? nullptr : &values[index];
+    }
+
+    T& getUnchecked(EntityId id) { return values[denseIndex(id)]; }
+
+    T* data() { return values.data(); }
+};
+
+// =================================================================
+// 13. ECS WORLD
+// =================================================================
+
+// Handle = index slot + generation; slot yang di-recycle menaikkan generation sehingga handle lama otomatis basi
+struct EntityHandle {
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == kInvalidIndex; }
+    uint64_t bits() const { return (uint64_t(generation) << 32) | index; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+class EntityRegistry {
+private:
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeList;
+
+public:
+    EntityHandle create() {
+        if (!freeList.empty()) {
+            uint32_t index = freeList.back();
+            freeList.pop_back();
+            return {index, generations[index]};
+        }
+        generations.push_back(0);
+        return {uint32_t(generations.size() - 1), 0};
+    }
+
+    bool destroy(EntityHandle h) {
+        if (!isAlive(h)) return false;
+        ++generations[h.index];
+        freeList.push_back(h.index);
+        return true;
+    }
+
+    bool isAlive(EntityHandle h) const { return h.index < generations.size() && generations[h.index] == h.generation; }
+
+    EntityHandle handleAt(EntityId index) const { return {index, generations[index]}; }
+
+    // n handle sekaligus ke out[0..n): slot bebas dulu (urutan sama seperti create berulang), lalu indeks baru
+    void createBatch(size_t n, EntityHandle* out) {
+        const size_t reused = std::min(n, freeList.size());
+        const size_t top = freeList.size() - 1;
+        for (size_t i = 0; i < reused; ++i) {
+            const uint32_t index = freeList[top - i];
+            out[i] = {index, generations[index]};
+        }
+        freeList.resize(freeList.size() - reused);
+        const uint32_t base = uint32_t(generations.size());
+        generations.resize(generations.size() + (n - reused), 0);
+        for (size_t i = reused; i < n; ++i) out[i] = {uint32_t(base + (i - reused)), 0};
+    }
+
+    size_t capacity() const { return generations.size(); }
+    size_t aliveCount() const { return generations.size() - freeList.size(); }
+
+    const std::vector<uint32_t>& generationList() const { return generations; }
+    const std::vector<uint32_t>& freeSlots() const { return freeList; }
+
+    void restore(std::vector<uint32_t> gens, std::vector<uint32_t> freeSlotList) {
+        generations = std::move(gens);
+        freeList = std::move(freeSlotList);
+    }
+};
+
+// Template entity yang sudah "dipanggang" (seperti PackedScene mob di Godot): mask archetype dan satu
+// prototipe per komponen table, dibuat sekali. ArchetypeWorld::instantiate menyalinnya ke N baris sekaligus.
+class Prefab {
+private:
+    ComponentMask componentSet;
+    std::vector<const ComponentInfo*> infos; // urut ComponentTypeId, sama dengan kolom archetype
+    std::vector<size_t> offsets;
+    std::unique_ptr<std::byte, ChunkBlockDeleter> storage;
+    ComponentMask constructed; // prototipe yang sudah dikonstruksi (bisa sebagian jika konstruktor melempar)
+
+    size_t slotOf(ComponentTypeId type) const {
+        for (size_t i = 0; i < infos.size(); ++i) {
+            if (infos[i]->id == type) return i;
+        }
+        throw std::runtime_error("Component is not part of the prefab");
+    }
+
+    template <typename T>
+    void store(T&& component) {
+        using Type = std::decay_t<T>;
+        new (storage.get() + offsets[slotOf(componentTypeId<Type>())]) Type(std::forward<T>(component));
+        constructed.set(componentTypeId<Type>());
+    }
+
+    void destroyPrototypes() {
+        if (!storage) return;
+        for (size_t i = 0; i < infos.size(); ++i) {
+            if (constructed.test(infos[i]->id)) infos[i]->destroyAt(storage.get() + offsets[i]);
+        }
+        constructed.reset();
+    }
+
+public:
+    template <typename... Ts>
+    explicit Prefab(Ts&&... components) : componentSet(componentMask<std::decay_t<Ts>...>()) {
+        static_assert(sizeof...(Ts) > 0, "prefab kosong");
+        static_assert(!(isSparseComponent<std::decay_t<Ts>> || ...), "komponen sparse tidak bisa masuk prefab");
+        static_assert((std::is_copy_constructible_v<std::decay_t<Ts>> && ...), "komponen prefab harus bisa di-copy");
+        if (componentSet.count() != sizeof...(Ts)) throw std::runtime_error("Duplicate component type in prefab");
+        size_t bytes = 0;
+        for (ComponentTypeId type = 0; type < kMaxComponentTypes; ++type) {
+            if (!componentSet.test(type)) continue;
+            const ComponentInfo& info = ComponentRegistry::getInstance().info(type);
+            bytes = (bytes + info.alignment - 1) / info.alignment * info.alignment;
+            infos.push_back(&info);
+            offsets.push_back(bytes);
+            bytes += info.size;
+        }
+        storage.reset(static_cast<std::byte*>(::operator new(std::max<size_t>(bytes, 1), std::align_val_t(kChunkAlignment))));
+        try {
+            (store(std::forward<Ts>(components)), ...);
+        } catch (...) {
+            destroyPrototypes();
+            throw;
+        }
+    }
+
+    Prefab(Prefab&& other) noexcept
+        : componentSet(other.componentSet), infos(std::move(other.infos)), offsets(std::move(other.offsets)),
+          storage(std::move(other.storage)), constructed(std::exchange(other.constructed, {})) {}
+
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+    Prefab& operator=(Prefab&&) = delete;
+
+    ~Prefab() { destroyPrototypes(); }
+
+    const ComponentMask& mask() const { return componentSet; }
+    size_t componentCount() const { return infos.size(); }
+    const ComponentInfo& info(size_t slot) const { return *infos[slot]; }
+    const void* prototype(size_t slot) const { return storage.get() + offsets[slot]; }
+
+    // Nilai awal bisa diubah setelah dibuat, mis. posisi spawn default
+    template <typename T>
+    T& get() {
+        return *std::launder(reinterpret_cast<T*>(storage.get() + offsets[slotOf(componentTypeId<T>())]));
+    }
+};
+
+class ArchetypeWorld {
+public:
+    struct ChunkRef {
+        Archetype* archetype;
+        size_t chunk;
+        uint32_t tick; // tick yang dicap ke komponen non-const yang diiterasi
+    };
+
+    // Query persisten: archetype yang cocok di-cache, dan setiap pemakaian hanya memeriksa archetype yang
+    // dibuat setelah refresh terakhir. Archetype tidak pernah dihapus, sedangkan create/destroy/pindah entity
+    // hanya mengubah isi chunk yang memang dibaca saat iterasi, jadi cache tidak perlu di-invalidate.
+    class Query {
+    public:
+        explicit Query(const ComponentMask& required) : required(required) {}
+
+        const ComponentMask& mask() const { return required; }
+        size_t archetypeCount() const { return matches.size(); }
+
+    private:
+        friend class ArchetypeWorld;
+
+        ComponentMask required;
+        uint64_t worldSerial = 0; // query dipakai di world lain -> cache dibangun ulang
+        size_t archetypesSeen = 0;
+        std::vector<Archetype*> matches;
+        std::vector<ChunkRef> chunks; // dipakai ulang tiap frame supaya tidak alokasi
+    };
+
+    template <typename... Ts>
+    static Query query() { return Query(componentMask<Ts...>()); }
+
+private:
+    friend class WorldSnapshot;
+    friend class WorldHistory;
+
+    struct EntityLocation {
+        uint32_t archetype;
+        uint32_t chunk;
+        uint32_t row;
+    };
+
+    std::shared_ptr<void> snapshotStorage; // file snapshot yang di-mmap; dilepas setelah semua archetype
+    EntityRegistry registry;
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<ComponentMask, uint32_t> archetypeLookup;
+    std::vector<EntityLocation> locations; // diindeks oleh EntityHandle::index
+    std::vector<std::unique_ptr<SparseSetBase>> sparsePools; // diindeks oleh ComponentTypeId
+    std::atomic<uint32_t> changeTick{1};
+    std::vector<std::function<void(EntityHandle)>> destroyListeners;
+    const uint64_t serial = nextSerial();
+
+    static uint64_t nextSerial() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    void refresh(Query& q) const {
+        if (q.worldSerial != serial) {
+            q.worldSerial = serial;
+            q.archetypesSeen = 0;
+            q.matches.clear();
+        }
+        for (; q.archetypesSeen < archetypes.size(); ++q.archetypesSeen) {
+            Archetype* arch = archetypes[q.archetypesSeen].get();
+            if ((arch->mask & q.required) == q.required) q.matches.push_back(arch);
+        }
+    }
+
+    uint32_t findOrCreateArchetype(const ComponentMask& mask) {
+        auto it = archetypeLookup.find(mask);
+        if (it != archetypeLookup.end()) return it->second;
+        uint32_t index = uint32_t(archetypes.size());
+        archetypes.push_back(std::make_unique<Archetype>(mask));
+        archetypeLookup.emplace(mask, index);
+        return index;
+    }
+
+    template <typename... Ts>
+    uint32_t archetypeFor() {
+        return findOrCreateArchetype(componentMask<Ts...>());
+    }
+
+    template <typename T>
+    static void markColumnWritten(const ChunkRef& ref) {
+        if constexpr (!std::is_const_v<T>) {
+            ref.archetype->stampColumn(ref.chunk, size_t(ref.archetype->columnIndex(componentTypeId<T>())), ref.tick);
+        }
+    }
+
+    template <typename T>
+    static void markRowWritten(const ChunkRef& ref, size_t row) {
+        if constexpr (!std::is_const_v<T>) {
+            ref.archetype->stampRow(ref.chunk, size_t(ref.archetype->columnIndex(componentTypeId<T>())), row, ref.tick);
+        }
+    }
+
+    void requireAlive(EntityHandle h) const {
+        if (!registry.isAlive(h)) throw std::runtime_error("Stale entity handle");
+    }
+
+    // Isi lubang dengan baris terakhir archetype (bukan hanya chunk yang sama) supaya semua chunk tetap padat;
+    // chunk terakhir yang kosong dilepas, jadi memori tidak tumbuh saat spawn/despawn terus-menerus.
+    // Komponen di baris lubang harus sudah di-destroy atau dipindahkan oleh pemanggil.
+    void removeRow(const EntityLocation& loc) {
+        Archetype& arch = *archetypes[loc.archetype];
+        ArchetypeChunk& hole = arch.chunks[loc.chunk];
+        ArchetypeChunk& tail = arch.chunks.back();
+        const size_t tailChunk = arch.chunks.size() - 1;
+        const size_t tailRow = tail.entities.size() - 1;
+        EntityId removed = hole.entities[loc.row];
+        EntityId moved = tail.entities.back();
+        if (loc.chunk != tailChunk || loc.row != tailRow) {
+            for (size_t c = 0; c < arch.infos.size(); ++c) {
+                arch.infos[c]->relocate(arch.cell(loc.chunk, c, loc.row), arch.cell(tailChunk, c, tailRow));
+                arch.stampRow(loc.chunk, c, loc.row, arch.rowTick(tailChunk, c, tailRow));
+            }
+        }
+        hole.entities[loc.row] = moved;
+        tail.entities.pop_back();
+        hole.structureTick = tail.structureTick = currentTick();
+        if (moved != removed) locations[moved] = loc;
+        if (tail.entities.empty()) arch.chunks.pop_back();
+    }
+
+    // Pindahkan semua kolom yang sama ke archetype tujuan (memcpy untuk tipe trivially relocatable);
+    // kolom yang tidak ada di tujuan di-destroy, kolom tambahan (jika ada) dikonstruksi pemanggil
+    EntityLocation relocate(EntityId id, uint32_t dstIndex) {
+        EntityLocation from = locations[id];
+        Archetype& src = *archetypes[from.archetype];
+        Archetype& dst = *archetypes[dstIndex];
+        size_t chunkIndex = dst.chunkWithSpace();
+        ArchetypeChunk& dstChunk = dst.chunks[chunkIndex];
+        const size_t row = dstChunk.entities.size();
+        for (size_t i = 0; i < src.types.size(); ++i) {
+            void* cell = src.cell(from.chunk, i, from.row);
+            int col = dst.columnIndex(src.types[i]);
+            if (col >= 0) {
+                src.infos[i]->relocate(dst.cell(chunkIndex, size_t(col), row), cell);
+                dst.stampRow(chunkIndex, size_t(col), row, src.rowTick(from.chunk, i, from.row));
+            } else {
+                src.infos[i]->destroyAt(cell);
+            }
+        }
+        dstChunk.entities.push_back(id);
+        dstChunk.structureTick = currentTick();
+        EntityLocation to{dstIndex, uint32_t(chunkIndex), uint32_t(row)};
+        removeRow(from);
+        locations[id] = to;
+        return to;
+    }
+
+    template <typename T, typename... Args>
+    T& addTableComponent(EntityId id, Args&&... args) {
+        Archetype* src = archetypes[locations[id].archetype].get();
+        ComponentMask mask = src->mask;
+        mask.set(componentTypeId<T>());
+        if (mask == src->mask) {
+            T& existing = getTableComponent<T>(id);
+            existing = T(std::forward<Args>(args)...);
+            return existing;
+        }
+
+        EntityLocation to = relocate(id, findOrCreateArchetype(mask));
+        Archetype& dst = *archetypes[to.archetype];
+        T* slot = dst.columnData<T>(to.chunk) + to.row;
+        new (slot) T(std::forward<Args>(args)...);
+        dst.stampRow(to.chunk, size_t(dst.columnIndex(componentTypeId<T>())), to.row, currentTick());
+        return *slot;
+    }
+
+    template <typename T>
+    void removeTableComponent(EntityId id) {
+        Archetype* src = archetypes[locations[id].archetype].get();
+        const ComponentTypeId removed = componentTypeId<T>();
+        if (!src->mask.test(removed)) return;
+        ComponentMask mask = src->mask;
+        mask.reset(removed);
+
+        relocate(id, findOrCreateArchetype(mask));
+    }
+
+    // Akses non-const dianggap menulis, jadi tick baris ikut diperbarui
+    template <typename T>
+    T& getTableComponent(EntityId id) {
+        const EntityLocation& loc = locations[id];
+        Archetype& arch = *archetypes[loc.archetype];
+        if constexpr (!std::is_const_v<T>) {
+            arch.stampRow(loc.chunk, size_t(arch.columnIndex(componentTypeId<T>())), loc.row, currentTick());
+        }
+        return arch.columnData<std::remove_const_t<T>>(loc.chunk)[loc.row];
+    }
+
+public:
+    template <typename... Ts>
+    EntityHandle createEntity(Ts&&... components) {
+        static_assert(!(isSparseComponent<std::decay_t<Ts>> || ...), "komponen sparse ditambahkan lewat addComponent");
+        EntityHandle h = registry.create();
+        uint32_t archIndex = archetypeFor<std::decay_t<Ts>...>();
+        Archetype& arch = *archetypes[archIndex];
+        size_t chunkIndex = arch.chunkWithSpace();
+        ArchetypeChunk& chunk = arch.chunks[chunkIndex];
+        const size_t row = chunk.entities.size();
+        (new (arch.columnData<std::decay_t<Ts>>(chunkIndex) + row) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+        for (size_t c = 0; c < arch.infos.size(); ++c) arch.stampRow(chunkIndex, c, row, currentTick());
+        chunk.entities.push_back(h.index);
+        chunk.structureTick = currentTick();
+        if (h.index >= locations.size()) locations.resize(h.index + 1);
+        locations[h.index] = {archIndex, uint32_t(chunkIndex), uint32_t(row)};
+        return h;
+    }
+
+    // Spawn massal dari prefab: archetype dicari sekali, lalu per chunk tiap kolom diisi utuh (memcpy berlipat
+    // untuk tipe bitwise-copyable, selain itu copy constructor per baris) dan tick baris di-fill sekaligus.
+    // `init(first, n, Ts*... columns)` dipanggil per potongan chunk dengan kolom SoA baris [first, first + n)
+    // dari batch ini, sudah berisi salinan prototipe, untuk inisialisasi per entity yang bisa divektorisasi.
+    // Jika copy constructor melempar, entity dari chunk sebelumnya tetap ada (handle-nya sudah di `out`).
+    template <typename... Ts, typename Fn>
+    void instantiate(const Prefab& prefab, size_t count, std::vector<EntityHandle>& out, Fn&& init) {
+        static_assert(!(isSparseComponent<std::remove_const_t<Ts>> || ...), "komponen sparse tidak ada di chunk");
+        const ComponentMask required = componentMask<Ts...>();
+        if ((prefab.mask() & required) != required) throw std::runtime_error("Prefab lacks a component requested by init");
+        const uint32_t archIndex = findOrCreateArchetype(prefab.mask());
+        Archetype& arch = *archetypes[archIndex];
+        const uint32_t tick = currentTick();
+        out.reserve(out.size() + count);
+        arch.chunks.reserve(arch.chunks.size() + (count + arch.chunkCapacity - 1) / arch.chunkCapacity + 1);
+
+        for (size_t done = 0; done < count;) {
+            const size_t chunkIndex = arch.chunkWithSpace();
+            ArchetypeChunk& chunk = arch.chunks[chunkIndex];
+            const size_t first = chunk.entities.size();
+            const size_t n = std::min(arch.chunkCapacity - first, count - done);
+
+            for (size_t c = 0; c < arch.infos.size(); ++c) {
+                const ComponentInfo& info = *arch.infos[c];
+                std::byte* column = static_cast<std::byte*>(arch.cell(chunkIndex, c, first));
+                const void* prototype = prefab.prototype(c);
+                if (info.bitwiseCopyable) {
+                    std::memcpy(column, prototype, info.size);
+                    for (size_t filled = 1; filled < n; filled *= 2) {
+                        std::memcpy(column + filled * info.size, column, std::min(filled, n - filled) * info.size);
+                    }
+                } else {
+                    size_t row = 0;
+                    try {
+                        for (; row < n; ++row) info.copyConstruct(column + row * info.size, prototype);
+                    } catch (...) {
+                        // Kolom ini sebagian, kolom sebelumnya utuh: bongkar semuanya, chunk kembali seperti semula
+                        while (row > 0) info.destroyAt(column + --row * info.size);
+                        for (size_t d = 0; d < c; ++d) {
+                            for (size_t r = 0; r < n; ++r) arch.infos[d]->destroyAt(arch.cell(chunkIndex, d, first + r));
+                        }
+                        if (chunk.entities.empty()) arch.chunks.pop_back();
+                        throw;
+                    }
+                }
+                std::fill_n(arch.rowTicks(chunkIndex, c) + first, n, tick);
+                chunk.columnTicks[c] = std::max(chunk.columnTicks[c], tick);
+            }
+
+            const size_t outFirst = out.size();
+            out.resize(outFirst + n);
+            const EntityHandle* created = out.data() + outFirst;
+            registry.createBatch(n, out.data() + outFirst);
+            if (locations.size() < registry.capacity()) locations.resize(registry.capacity());
+            chunk.entities.resize(first + n);
+            for (size_t i = 0; i < n; ++i) {
+                chunk.entities[first + i] = created[i].index;
+                locations[created[i].index] = {archIndex, uint32_t(chunkIndex), uint32_t(first + i)};
+            }
+            chunk.structureTick = tick;
+            init(done, n, (arch.columnData<std::remove_const_t<Ts>>(chunkIndex) + first)...);
+            done += n;
+        }
+    }
+
+    void instantiate(const Prefab& prefab, size_t count, std::vector<EntityHandle>& out) {
+        instantiate<>(prefab, count, out, [](size_t, size_t) {});
+    }
+
+    bool destroyEntity(EntityHandle h) {
+        if (!registry.isAlive(h)) return false;
+        const EntityLocation loc = locations[h.index];
+        archetypes[loc.archetype]->destroyRow(loc.chunk, loc.row);
+        removeRow(loc);
+        for (auto& pool : sparsePools) {
+            if (pool) pool->remove(h.index);
+        }
+        registry.destroy(h);
+        for (auto& listener : destroyListeners) listener(h);
+        return true;
+    }
+
+    // Dipanggil setelah destroyEntity selesai (h sudah basi), mis. supaya hierarki ikut membuang node-nya
+    // walau entity dihapus langsung lewat world, bukan SceneManager::despawn
+    void onDestroy(std::function<void(EntityHandle)> listener) { destroyListeners.push_back(std::move(listener)); }
+
+    bool isAlive(EntityHandle h) const { return registry.isAlive(h); }
+
+    // Tick perubahan: SystemScheduler menaikkannya setiap kali sebuah sistem selesai, sehingga perubahan
+    // yang dibuat sesudahnya (oleh sistem lain atau kode di luar scheduler) selalu lebih baru dari tick
+    // yang dicatat sistem itu saat mulai
+    uint32_t currentTick() const { return changeTick.load(std::memory_order_relaxed); }
+    uint32_t advanceTick() { return changeTick.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    template <typename T>
+    SparseSet<T>& pool() {
+        ComponentTypeId type = componentTypeId<T>();
+        if (type >= sparsePools.size()) sparsePools.resize(type + 1);
+        if (!sparsePools[type]) sparsePools[type] = std::make_unique<SparseSet<T>>();
+        return static_cast<SparseSet<T>&>(*sparsePools[type]);
+    }
+
+    // Komponen table memindahkan entity ke archetype baru (mask lama + T); komponen sparse cukup masuk pool
+    template <typename T, typename... Args>
+    T& addComponent(EntityHandle h, Args&&... args) {
+        requireAlive(h);
+        if constexpr (isSparseComponent<T>) {
+            return pool<T>().emplace(h.index, std::forward<Args>(args)...);
+        } else {
+            return addTableComponent<T>(h.index, std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename T>
+    void removeComponent(EntityHandle h) {
+        requireAlive(h);
+        if constexpr (isSparseComponent<T>) {
+            pool<T>().remove(h.index);
+        } else {
+            removeTableComponent<T>(h.index);
+        }
+    }
+
+    template <typename T>
+    bool hasComponent(EntityHandle h) {
+        if (!registry.isAlive(h)) return false;
+        if constexpr (isSparseComponent<T>) {
+            return pool<T>().contains(h.index);
+        } else {
+            return archetypes[locations[h.index].archetype]->mask.test(componentTypeId<T>());
+        }
+    }
+
+    // `getComponent<const T>` membaca tanpa menandai komponen sebagai berubah (hanya berlaku untuk table)
+    template <typename T>
+    T* getComponent(EntityHandle h) {
+        if (!registry.isAlive(h)) return nullptr;
+        if constexpr (isSparseComponent<std::remove_const_t<T>>) {
+            return pool<std::remove_const_t<T>>().get(h.index);
+        } else {
+            if (!archetypes[locations[h.index].archetype]->mask.test(componentTypeId<T>())) return nullptr;
+            return &getTableComponent<T>(h.index);
+        }
+    }
+
+    // Versi cache: hanya archetype baru yang dicek, list chunk milik query dipakai ulang
+    const std::vector<ChunkRef>& chunksMatching(Query& q) {
+        refresh(q);
+        q.chunks.clear();
+        const uint32_t tick = currentTick();
+        for (Archetype* arch : q.matches) {
+            for (size_t c = 0; c < arch->chunks.size(); ++c) q.chunks.push_back({arch, c, tick});
+        }
+        return q.chunks;
+    }
+
+    // Scan semua archetype; cukup untuk pemakaian sesekali, sistem per-frame sebaiknya memakai Query
+    std::vector<ChunkRef> chunksMatching(const ComponentMask& required) {
+        std::vector<ChunkRef> result;
+        const uint32_t tick = currentTick();
+        for (auto& arch : archetypes) {
+            if ((arch->mask & required) != required) continue;
+            for (size_t c = 0; c < arch->chunks.size(); ++c) result.push_back({arch.get(), c, tick});
+        }
+        return result;
+    }
+
+    template <typename... Ts, typename Fn>
+    static void eachInChunk(const ChunkRef& ref, Fn&& fn) {
+        const size_t count = ref.archetype->chunks[ref.chunk].entities.size();
+        std::tuple<Ts*...> columns(ref.archetype->columnData<std::remove_const_t<Ts>>(ref.chunk)...);
+        for (size_t i = 0; i < count; ++i) fn(std::get<Ts*>(columns)[i]...);
+        (markColumnWritten<Ts>(ref), ...);
+    }
+
+    // Hanya baris yang komponen pertamanya (Ts pertama) berubah setelah `sinceTick`; chunk yang tick
+    // maksimumnya tidak lebih baru dilewati tanpa menyentuh datanya
+    template <typename... Ts, typename Fn>
+    static void eachChangedInChunk(const ChunkRef& ref, uint32_t sinceTick, Fn&& fn) {
+        using Watched = std::tuple_element_t<0, std::tuple<Ts...>>;
+        Archetype& arch = *ref.archetype;
+        const size_t watched = size_t(arch.columnIndex(componentTypeId<Watched>()));
+        if (arch.chunks[ref.chunk].columnTicks[watched] <= sinceTick) return;
+        const size_t count = arch.chunks[ref.chunk].entities.size();
+        const uint32_t* ticks = arch.rowTicks(ref.chunk, watched);
+        const bool wholeColumn = arch.chunks[ref.chunk].wholeColumnTicks[watched] > sinceTick;
+        std::tuple<Ts*...> columns(arch.columnData<std::remove_const_t<Ts>>(ref.chunk)...);
+        for (size_t i = 0; i < count; ++i) {
+            if (!wholeColumn && ticks[i] <= sinceTick) continue;
+            fn(std::get<Ts*>(columns)[i]...);
+            (markRowWritten<Ts>(ref, i), ...);
+        }
+    }
+
+    // Iterasi linear per kolom: fn(Ts&...) untuk setiap entity yang punya semua Ts.
+    // Ts non-const dianggap ditulis; gunakan `const T` untuk komponen yang hanya dibaca.
+    template <typename... Ts, typename Fn>
+    void each(Fn&& fn) {
+        for (const ChunkRef& ref : chunksMatching(componentMask<Ts...>())) eachInChunk<Ts...>(ref, fn);
+    }
+
+    template <typename... Ts, typename Fn>
+    void eachChanged(uint32_t sinceTick, Fn&& fn) {
+        for (const ChunkRef& ref : chunksMatching(componentMask<Ts...>())) eachChangedInChunk<Ts...>(ref, sinceTick, fn);
+    }
+
+    // Tick terakhir komponen T milik entity ditulis; 0 jika entity atau komponennya tidak ada
+    template <typename T>
+    uint32_t changeTickOf(EntityHandle h) {
+        static_assert(!isSparseComponent<std::remove_const_t<T>>, "change tick hanya ada untuk komponen table");
+        if (!registry.isAlive(h)) return 0;
+        const EntityLocation& loc = locations[h.index];
+        Archetype& arch = *archetypes[loc.archetype];
+        int col = arch.columnIndex(componentTypeId<T>());
+        return col < 0 ? 0 : arch.rowTick(loc.chunk, size_t(col), loc.row);
+    }
+
+    // fn(EntityHandle) untuk setiap entity yang komponen T-nya berubah setelah `sinceTick`
+    template <typename T, typename Fn>
+    void eachChangedEntity(uint32_t sinceTick, Fn&& fn) {
+        for (const ChunkRef& ref : chunksMatching(componentMask<T>())) {
+            Archetype& arch = *ref.archetype;
+            const ArchetypeChunk& chunk = arch.chunks[ref.chunk];
+            const size_t col = size_t(arch.columnIndex(componentTypeId<T>()));
+            if (chunk.columnTicks[col] <= sinceTick) continue;
+            const bool wholeColumn = chunk.wholeColumnTicks[col] > sinceTick;
+            const uint32_t* ticks = arch.rowTicks(ref.chunk, col);
+            for (size_t i = 0; i < chunk.entities.size(); ++i) {
+                if (wholeColumn || ticks[i] > sinceTick) fn(registry.handleAt(chunk.entities[i]));
+            }
+        }
+    }
+
+    // Sama dengan each<Ts...>(fn), tapi pencocokan archetype memakai cache milik `q`
+    template <typename... Ts, typename Fn>
+    void each(Query& q, Fn&& fn) {
+        for (const ChunkRef& ref : chunksMatching(q)) eachInChunk<Ts...>(ref, fn);
+    }
+
+    // Seperti each(q, fn), tapi fn juga menerima handle entity: fn(EntityHandle, Ts&...)
+    template <typename... Ts, typename Fn>
+    void eachEntity(Query& q, Fn&& fn) {
+        for (const ChunkRef& ref : chunksMatching(q)) {
+            const std::vector<EntityId>& ids = ref.archetype->chunks[ref.chunk].entities;
+            std::tuple<Ts*...> columns(ref.archetype->columnData<std::remove_const_t<Ts>>(ref.chunk)...);
+            for (size_t i = 0; i < ids.size(); ++i) fn(registry.handleAt(ids[i]), std::get<Ts*>(columns)[i]...);
+            (markColumnWritten<Ts>(ref), ...);
+        }
+    }
+
+    // View multi-komponen sparse: iterasi pool terkecil, cek keanggotaan sisanya O(1)
+    template <typename... Ts, typename Fn>
+    void view(Fn&& fn) {
+        static_assert((isSparseComponent<Ts> && ...), "view<> hanya untuk komponen sparse; gunakan each<> untuk table");
+        std::tuple<SparseSet<Ts>&...> pools(pool<Ts>()...);
+        const SparseSetBase* sizes[] = {&std::get<SparseSet<Ts>&>(pools)...};
+        const SparseSetBase* smallest = *std::min_element(std::begin(sizes), std::end(sizes),
+                                                          [](auto* a, auto* b) { return a->size() < b->size(); });
+        const auto& candidates = smallest->entities();
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            EntityId id = candidates[i];
+            if ((std::get<SparseSet<Ts>&>(pools).contains(id) && ...)) {
+                fn(registry.handleAt(id), std::get<SparseSet<Ts>&>(pools).getUnchecked(id)...);
+            }
+        }
+    }
+
+    const EntityRegistry& getRegistry() const { return registry; }
+    size_t entityCount() const { return registry.aliveCount(); }
+    size_t archetypeCount() const { return archetypes.size(); }
+
+    size_t chunkCount() const {
+        size_t n = 0;
+        for (auto& arch : archetypes) n += arch->chunks.size();
+        return n;
+    }
+};
+
+// =================================================================
+// 14. WORLD SNAPSHOT (Binary, mmap)
+// =================================================================
+
+// File dipetakan MAP_PRIVATE (copy-on-write): chunk langsung memakai halaman file, halaman yang ditulis
+// (fix-up, perubahan oleh game) disalin kernel secara lazy. Tanpa mmap, file dibaca ke buffer ter-align.
+class MappedFile {
+private:
+    std::byte* bytes = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open snapshot: " + path);
+        struct stat info;
+        length = ::fstat(fd, &info) == 0 ? size_t(info.st_size) : 0;
+        void* p = length ? ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot map snapshot: " + path);
+        bytes = static_cast<std::byte*>(p);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("Cannot open snapshot: " + path);
+        length = size_t(in.tellg());
+        bytes = static_cast<std::byte*>(::operator new(length, std::align_val_t(kChunkAlignment)));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(bytes), std::streamsize(length));
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+        ::munmap(bytes, length);
+#else
+        ::operator delete(bytes, std::align_val_t(kChunkAlignment));
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::byte* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Format: header tetap -> metadata (tabel tipe, registry, archetype, payload komponen non-relocatable)
+// -> blok chunk mentah ter-align 64 byte, persis seperti di memori. Saat load, chunk menunjuk langsung ke
+// blok di file. Tipe POD dipakai apa adanya; tipe non-relocatable (mis. MeshComponent) dan tipe polimorfik
+// (vptr tidak boleh ditambal sebagai byte) dibangun ulang di tempat dengan placement-new dari payload
+// ComponentSerializer. File hanya valid untuk build yang sama (layout), jadi stempel build ikut dicek.
+
+// File valid tapi tidak cocok dengan proses ini (format/build lain, tipe tidak dikenal, layout berubah); world
+// belum disentuh, jadi pemanggil boleh jatuh ke scene lain
+struct SnapshotMismatch : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+class WorldSnapshot {
+private:
+    static constexpr char kMagic[8] = {'N', 'L', 'F', 'T', 'W', 'L', 'D', '1'};
+    static constexpr uint32_t kVersion = 2;
+    static constexpr uint32_t kNoType = 0xFFFFFFFFu;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t pointerSize;
+        char build[32];
+        uint64_t metaBytes;
+        uint64_t blocksOffset;
+    };
+
+    static const char* buildStamp() { return __DATE__ " " __TIME__; }
+
+    static size_t alignUp(size_t value) { return (value + kChunkAlignment - 1) / kChunkAlignment * kChunkAlignment; }
+
+    // Kolom yang isinya tidak bisa dipakai sebagai byte mentah dari file lain (tipe polimorfik selalu di sini)
+    static bool needsPayload(const ComponentInfo& info) { return !info.triviallyRelocatable; }
+
+    static bool hasPayloadColumns(const Archetype& arch) {
+        return std::any_of(arch.infos.begin(), arch.infos.end(), [](const ComponentInfo* info) { return needsPayload(*info); });
+    }
+
+public:
+    static void save(ArchetypeWorld& world, const std::string& path) {
+        for (auto& pool : world.sparsePools) {
+            if (pool && pool->size() > 0) throw std::runtime_error("Sparse components are not part of world snapshots");
+        }
+
+        std::string meta;
+        ByteWriter out(meta);
+
+        std::vector<ComponentTypeId> fileTypes;
+        std::array<uint32_t, kMaxComponentTypes> fileIndex;
+        fileIndex.fill(kNoType);
+        std::vector<Archetype*> stored;
+        for (auto& arch : world.archetypes) {
+            if (arch->chunks.empty()) continue;
+            stored.push_back(arch.get());
+            for (const ComponentInfo* info : arch->infos) {
+                if (fileIndex[info->id] != kNoType) continue;
+                if (needsPayload(*info) && !info->serialize) {
+                    throw std::runtime_error("Component type cannot be snapshotted: " + std::string(info->name));
+                }
+                fileIndex[info->id] = uint32_t(fileTypes.size());
+                fileTypes.push_back(info->id);
+            }
+        }
+        out.pod(uint32_t(fileTypes.size()));
+        for (ComponentTypeId id : fileTypes) {
+            const ComponentInfo& info = ComponentRegistry::getInstance().info(id);
+            out.string(info.name);
+            out.pod(uint32_t(info.size));
+            out.pod(uint32_t(info.alignment));
+        }
+
+        const auto& generations = world.registry.generationList();
+        const auto& freeSlots = world.registry.freeSlots();
+        out.pod(uint64_t(generations.size()));
+        out.bytes(generations.data(), generations.size() * sizeof(uint32_t));
+        out.pod(uint64_t(freeSlots.size()));
+        out.bytes(freeSlots.data(), freeSlots.size() * sizeof(uint32_t));
+
+        uint64_t blockCursor = 0;
+        out.pod(uint32_t(stored.size()));
+        for (Archetype* arch : stored) {
+            out.pod(uint32_t(arch->types.size()));
+            for (ComponentTypeId type : arch->types) out.pod(fileIndex[type]);
+            out.pod(uint64_t(arch->chunkCapacity));
+            out.pod(uint64_t(arch->blockBytes));
+            for (size_t offset : arch->columnOffsets) out.pod(uint64_t(offset));
+            out.pod(uint32_t(arch->chunks.size()));
+            for (size_t c = 0; c < arch->chunks.size(); ++c) {
+                const auto& entities = arch->chunks[c].entities;
+                out.pod(uint32_t(entities.size()));
+                out.bytes(entities.data(), entities.size() * sizeof(EntityId));
+                out.pod(blockCursor);
+                blockCursor += arch->blockBytes;
+                for (size_t col = 0; col < arch->infos.size(); ++col) {
+                    if (!needsPayload(*arch->infos[col])) continue;
+                    for (size_t row = 0; row < entities.size(); ++row) arch->infos[col]->serialize(arch->cell(c, col, row), out);
+                }
+            }
+        }
+
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.pointerSize = uint32_t(sizeof(void*));
+        std::strncpy(header.build, buildStamp(), sizeof(header.build) - 1);
+        header.metaBytes = meta.size();
+        header.blocksOffset = alignUp(sizeof(Header) + meta.size());
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("Cannot write snapshot: " + path);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(meta.data(), std::streamsize(meta.size()));
+        std::string padding(header.blocksOffset - sizeof(Header) - meta.size(), '\0');
+        file.write(padding.data(), std::streamsize(padding.size()));
+
+        // Kolom payload berisi pointer (heap, vptr); di file diganti nol karena isinya dibangun ulang dari payload
+        std::vector<std::byte> scratch;
+        for (Archetype* arch : stored) {
+            const bool scrub = hasPayloadColumns(*arch);
+            for (auto& chunk : arch->chunks) {
+                const std::byte* block = chunk.block.get();
+                if (scrub) {
+                    scratch.assign(block, block + arch->blockBytes);
+                    for (size_t col = 0; col < arch->infos.size(); ++col) {
+                        if (!needsPayload(*arch->infos[col])) continue;
+                        std::memset(scratch.data() + arch->columnOffsets[col], 0, arch->infos[col]->size * arch->chunkCapacity);
+                    }
+                    block = scratch.data();
+                }
+                file.write(reinterpret_cast<const char*>(block), std::streamsize(arch->blockBytes));
+            }
+        }
+        if (!file) throw std::runtime_error("Cannot write snapshot: " + path);
+    }
+
+    // Tipe komponen di file harus sudah terdaftar di proses ini (registerComponentTypes / componentTypeId<T>())
+    static void load(ArchetypeWorld& world, const std::string& path) {
+        if (world.registry.capacity() != 0 || !world.archetypes.empty()) {
+            throw std::runtime_error("Snapshot must be loaded into an empty world");
+        }
+        auto file = std::make_shared<MappedFile>(path);
+        ByteReader headerIn(file->data(), file->size());
+        const Header header = headerIn.pod<Header>();
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+            throw SnapshotMismatch("Not a world snapshot: " + path);
+        }
+        if (header.pointerSize != sizeof(void*) || std::strncmp(header.build, buildStamp(), sizeof(header.build)) != 0) {
+            throw SnapshotMismatch("Snapshot was written by a different build: " + path);
+        }
+        ByteReader in(headerIn.take(header.metaBytes), header.metaBytes);
+
+        const uint32_t typeCount = in.pod<uint32_t>();
+        if (typeCount > kMaxComponentTypes) throw std::runtime_error("Corrupt snapshot");
+        std::vector<ComponentTypeId> types(typeCount);
+        for (auto& type : types) {
+            const std::string name = in.string();
+            const uint32_t size = in.pod<uint32_t>();
+            const uint32_t alignment = in.pod<uint32_t>();
+            const ComponentInfo* info = ComponentRegistry::getInstance().find(name);
+            if (!info) throw SnapshotMismatch("Unknown component type in snapshot: " + name);
+            if (info->size != size || info->alignment != alignment) throw SnapshotMismatch("Component layout changed: " + name);
+            type = info->id;
+        }
+
+        std::vector<uint32_t> generations, freeSlots;
+        in.podArray(generations, size_t(in.pod<uint64_t>()));
+        in.podArray(freeSlots, size_t(in.pod<uint64_t>()));
+        world.locations.assign(generations.size(), {});
+        world.registry.restore(std::move(generations), std::move(freeSlots));
+
+        // Semua atau tidak sama sekali: file rusak di tengah jalan mengembalikan world ke keadaan kosong
+        try {
+            const uint32_t tick = world.currentTick();
+            const uint32_t archetypeCount = in.pod<uint32_t>();
+            for (uint32_t a = 0; a < archetypeCount; ++a) {
+                ComponentMask mask;
+                const uint32_t columnCount = in.pod<uint32_t>();
+                for (uint32_t t = 0; t < columnCount; ++t) {
+                    const uint32_t index = in.pod<uint32_t>();
+                    if (index >= types.size()) throw std::runtime_error("Corrupt snapshot");
+                    mask.set(types[index]);
+                }
+                const uint32_t archIndex = world.findOrCreateArchetype(mask);
+                Archetype& arch = *world.archetypes[archIndex];
+                bool sameLayout = in.pod<uint64_t>() == arch.chunkCapacity && in.pod<uint64_t>() == arch.blockBytes;
+                for (size_t offset : arch.columnOffsets) sameLayout = in.pod<uint64_t>() == offset && sameLayout;
+                if (!sameLayout) throw std::runtime_error("Snapshot chunk layout mismatch: " + path);
+
+                const uint32_t chunkCount = in.pod<uint32_t>();
+                for (uint32_t c = 0; c < chunkCount; ++c) {
+                    ArchetypeChunk chunk;
+                    const uint32_t rows = in.pod<uint32_t>();
+                    if (rows > arch.chunkCapacity) throw std::runtime_error("Corrupt snapshot");
+                    in.podArray(chunk.entities, rows);
+                    for (EntityId id : chunk.entities) {
+                        if (id >= world.locations.size()) throw std::runtime_error("Corrupt snapshot");
+                    }
+                    const uint64_t offset = header.blocksOffset + in.pod<uint64_t>();
+                    if (offset + arch.blockBytes > file->size()) throw std::runtime_error("Truncated snapshot");
+                    std::byte* block = file->data() + offset;
+                    chunk.block = std::unique_ptr<std::byte, ChunkBlockDeleter>(block, ChunkBlockDeleter{false});
+                    chunk.entities.reserve(arch.chunkCapacity);
+                    chunk.rowTicks.assign(arch.infos.size() * arch.chunkCapacity, 0);
+                    chunk.columnTicks.assign(arch.infos.size(), tick);
+                    chunk.wholeColumnTicks.assign(arch.infos.size(), tick);
+                    chunk.structureTick = tick;
+
+                    // Dibangun sebelum chunk dipasang, supaya archetype tidak pernah melihat baris setengah jadi;
+                    // kalau payload rusak (atau chunk gagal dipasang), baris chunk ini yang sudah dibangun dihancurkan lagi
+                    size_t col = 0, built = 0;
+                    try {
+                        for (; col < arch.infos.size(); ++col) {
+                            const ComponentInfo& info = *arch.infos[col];
+                            if (!needsPayload(info)) continue;
+                            std::byte* column = block + arch.columnOffsets[col];
+                            for (built = 0; built < rows; ++built) info.deserialize(column + built * info.size, in);
+                        }
+                        arch.chunks.push_back(std::move(chunk));
+                    } catch (...) {
+                        for (size_t done = 0; done <= col && done < arch.infos.size(); ++done) {
+                            const ComponentInfo& info = *arch.infos[done];
+                            if (!needsPayload(info)) continue;
+                            const size_t count = done < col ? rows : built;
+                            for (size_t row = 0; row < count; ++row) info.destroyAt(block + arch.columnOffsets[done] + row * info.size);
+                        }
+                        throw;
+                    }
+                    const uint32_t chunkIndex = uint32_t(arch.chunks.size() - 1);
+                    for (uint32_t row = 0; row < rows; ++row) world.locations[arch.chunks.back().entities[row]] = {archIndex, chunkIndex, row};
+                }
+            }
+        } catch (...) {
+            world.archetypes.clear();
+            world.archetypeLookup.clear();
+            world.locations.clear();
+            world.registry.restore({}, {});
+            throw;
+        }
+        world.snapshotStorage = std::move(file);
+    }
+};
+
+// =================================================================
+// 15. ROLLBACK HISTORY (Per-frame Delta Ring)
+// =================================================================
+
+// Ring N frame terakhir untuk replay, debugging, dan resimulasi deterministik. Tiap kolom chunk disimpan
+// sebagai XOR terhadap keyframe lalu dikodekan zero-run; kolom yang tick-nya tidak berubah sejak frame
+// sebelumnya cukup berbagi blob frame itu, jadi capture hanya menyentuh chunk yang berubah. Delta selalu
+// relatif ke keyframe (bukan berantai), sehingga restore frame mana pun = salin keyframe + XOR satu delta.
+// Keyframe baru diambil begitu delta sudah lebih dari separuh ukurannya.
+//
+// Yang tidak ikut: komponen sparse (capture melempar jika ada), hierarki parent/child, entity legacy.
+// Gambar kolom tipe relocatable adalah byte mentah; tipe lain (termasuk semua tipe polimorfik) lewat
+// ComponentSerializer. Tulisan lewat pointer yang disimpan di luar API world tidak terdeteksi.
+class WorldHistory {
+private:
+    using Bytes = std::vector<uint8_t>;
+
+    // Kode: berulang [varint byte sama][varint panjang literal][literal = cur XOR base]; sisa yang tidak
+    // disebut sama dengan base (base lebih pendek dianggap diisi nol)
+    struct Delta {
+        size_t bytes = 0;
+        Bytes code;
+    };
+
+    struct ChunkState {
+        std::shared_ptr<const std::vector<EntityId>> entities;
+        std::vector<std::shared_ptr<const Delta>> columns;
+    };
+
+    struct ArchetypeState {
+        ComponentMask mask;
+        std::vector<ChunkState> chunks;
+    };
+
+    struct Keyframe {
+        std::vector<std::vector<std::vector<Bytes>>> columns; // [archetype][chunk][kolom]
+        size_t bytes = 0;
+
+        const Bytes* image(size_t archetype, size_t chunk, size_t column) const {
+            if (archetype >= columns.size() || chunk >= columns[archetype].size()) return nullptr;
+            return &columns[archetype][chunk][column];
+        }
+    };
+
+    struct Frame {
+        uint32_t tick = 0; // tulisan dengan tick lebih besar terjadi setelah capture ini
+        std::shared_ptr<const Keyframe> keyframe;
+        std::vector<ArchetypeState> archetypes; // sejajar dengan world.archetypes saat capture
+        std::shared_ptr<const std::vector<uint32_t>> generations;
+        std::shared_ptr<const std::vector<uint32_t>> freeSlots;
+        size_t deltaBytes = 0;
+    };
+
+    // Satu kolom chunk yang berubah; slot tujuan sudah dialokasikan sebelum job dibagi ke worker
+    struct EncodeJob {
+        Archetype* arch;
+        size_t archetype;
+        size_t chunk;
+        size_t column;
+        std::shared_ptr<const Delta>* out;
+        Bytes* keyImage; // non-null saat frame ini keyframe baru
+    };
+
+    static constexpr size_t kEncodeGrain = 4;
+
+    WorkerPool& pool;
+    size_t capacity;
+    std::deque<Frame> frames;
+    std::vector<EncodeJob> jobs;
+    uint64_t worldSerial = 0;
+    bool forceFull = true; // setelah restore / ganti world, tick chunk tidak lagi relatif ke frame terakhir
+    Bytes decoded;
+
+    static void putVarint(Bytes& out, size_t value) {
+        while (value >= 0x80) {
+            out.push_back(uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(uint8_t(value));
+    }
+
+    static size_t getVarint(const uint8_t*& p) {
+        size_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            const uint8_t b = *p++;
+            value |= size_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return value;
+        }
+    }
+
+    // Dibandingkan per word 8 byte; literal berhenti di word pertama yang sama. Kode ditulis ke buffer
+    // `code` milik thread pemanggil lalu disalin sekali dengan ukuran pas.
+    static std::shared_ptr<const Delta> encode(const uint8_t* cur, size_t size, const Bytes* base, Bytes& code) {
+        const uint8_t* ref = base ? base->data() : nullptr;
+        const size_t baseSize = base ? base->size() : 0;
+        size_t emitted = 0;
+        code.clear();
+        auto flush = [&](size_t begin, size_t end) {
+            putVarint(code, begin - emitted);
+            putVarint(code, end - begin);
+            const size_t at = code.size();
+            code.resize(at + (end - begin));
+            uint8_t* out = code.data() + at;
+            for (size_t k = begin; k < end; ++k) out[k - begin] = uint8_t(cur[k] ^ (k < baseSize ? ref[k] : 0));
+            emitted = end;
+        };
+
+        constexpr size_t kNone = ~size_t(0);
+        size_t runStart = kNone;
+        const size_t words = std::min(size, baseSize) & ~size_t(7);
+        size_t at = 0;
+        for (; at < words; at += 8) {
+            uint64_t a, b;
+            std::memcpy(&a, cur + at, 8);
+            std::memcpy(&b, ref + at, 8);
+            if (a != b) {
+                if (runStart == kNone) runStart = at;
+            } else if (runStart != kNone) {
+                flush(runStart, at);
+                runStart = kNone;
+            }
+        }
+        // Ekor yang tidak genap satu word atau melewati panjang base dianggap satu literal
+        bool tailDiffers = false;
+        for (size_t k = at; k < size && !tailDiffers; ++k) tailDiffers = cur[k] != (k < baseSize ? ref[k] : 0);
+        if (tailDiffers) {
+            flush(runStart == kNone ? at : runStart, size);
+        } else if (runStart != kNone) {
+            flush(runStart, at);
+        }
+
+        auto delta = std::make_shared<Delta>();
+        delta->bytes = size;
+        delta->code.assign(code.begin(), code.end());
+        return delta;
+    }
+
+    static void decode(const Delta& delta, const Bytes* base, uint8_t* dst) {
+        const size_t common = base ? std::min(base->size(), delta.bytes) : 0;
+        if (common) std::memcpy(dst, base->data(), common);
+        std::memset(dst + common, 0, delta.bytes - common);
+        const uint8_t* p = delta.code.data();
+        const uint8_t* end = p + delta.code.size();
+        size_t at = 0;
+        while (p < end) {
+            at += getVarint(p);
+            const size_t n = getVarint(p);
+            size_t k = 0;
+            for (; k + 8 <= n; k += 8) {
+                uint64_t a, x;
+                std::memcpy(&a, dst + at + k, 8);
+                std::memcpy(&x, p + k, 8);
+                a ^= x;
+                std::memcpy(dst + at + k, &a, 8);
+            }
+            for (; k < n; ++k) dst[at + k] ^= p[k];
+            p += n;
+            at += n;
+        }
+    }
+
+    // Byte kolom apa adanya untuk tipe relocatable; tipe lain diserialisasi ke `serialized`
+    static std::pair<const uint8_t*, size_t> columnImage(Archetype& arch, size_t chunk, size_t column, std::string& serialized) {
+        const ComponentInfo& info = *arch.infos[column];
+        const size_t rows = arch.chunks[chunk].entities.size();
+        if (info.triviallyRelocatable) return {reinterpret_cast<const uint8_t*>(arch.cell(chunk, column, 0)), rows * info.size};
+        serialized.clear();
+        ByteWriter out(serialized);
+        for (size_t row = 0; row < rows; ++row) info.serialize(arch.cell(chunk, column, row), out);
+        return {reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()};
+    }
+
+public:
+    explicit WorldHistory(size_t frameCount = 64, WorkerPool& p = WorkerPool::getInstance())
+        : pool(p), capacity(std::max<size_t>(1, frameCount)) {}
+
+    size_t size() const { return frames.size(); }
+    size_t frameCapacity() const { return capacity; }
+
+    // Byte yang benar-benar dipegang ring: keyframe + blob delta unik (blob yang dibagi dihitung sekali)
+    size_t memoryBytes() const {
+        std::unordered_map<const void*, size_t> unique;
+        for (const Frame& frame : frames) {
+            unique.emplace(frame.keyframe.get(), frame.keyframe->bytes);
+            for (const ArchetypeState& arch : frame.archetypes) {
+                for (const ChunkState& chunk : arch.chunks) {
+                    unique.emplace(chunk.entities.get(), chunk.entities->size() * sizeof(EntityId));
+                    for (const auto& column : chunk.columns) unique.emplace(column.get(), column->code.size());
+                }
+            }
+            unique.emplace(frame.generations.get(), frame.generations->size() * sizeof(uint32_t));
+            unique.emplace(frame.freeSlots.get(), frame.freeSlots->size() * sizeof(uint32_t));
+        }
+        size_t total = 0;
+        for (const auto& entry : unique) total += entry.second;
+        return total;
+    }
+
+    // Dipanggil sekali per frame setelah update; menaikkan tick world supaya tulisan berikutnya terdeteksi.
+    // Pass serial memilih kolom yang bisa dibagi dengan frame sebelumnya; sisanya di-encode paralel per kolom.
+    void capture(ArchetypeWorld& world) {
+        for (auto& sparse : world.sparsePools) {
+            if (sparse && sparse->size() > 0) throw std::runtime_error("Sparse components are not part of rollback history");
+        }
+        if (world.serial != worldSerial) {
+            worldSerial = world.serial;
+            forceFull = true;
+        }
+
+        const Frame* prev = frames.empty() ? nullptr : &frames.back();
+        const bool newKeyframe = !prev || prev->deltaBytes * 2 > prev->keyframe->bytes;
+        std::shared_ptr<Keyframe> key;
+        if (newKeyframe) key = std::make_shared<Keyframe>();
+        const bool reuse = prev && !forceFull && !newKeyframe;
+
+        Frame frame;
+        frame.tick = world.currentTick();
+        frame.archetypes.resize(world.archetypes.size());
+        if (key) key->columns.resize(world.archetypes.size());
+        jobs.clear();
+        bool structural = !reuse;
+        for (size_t a = 0; a < world.archetypes.size(); ++a) {
+            Archetype& arch = *world.archetypes[a];
+            ArchetypeState& state = frame.archetypes[a];
+            state.mask = arch.mask;
+            state.chunks.resize(arch.chunks.size());
+            const ArchetypeState* prevArch = reuse && a < prev->archetypes.size() ? &prev->archetypes[a] : nullptr;
+            if (!prevArch || prevArch->chunks.size() != arch.chunks.size()) structural = true;
+            if (key) key->columns[a].resize(arch.chunks.size());
+
+            for (size_t c = 0; c < arch.chunks.size(); ++c) {
+                const ArchetypeChunk& chunk = arch.chunks[c];
+                ChunkState& out = state.chunks[c];
+                const ChunkState* before = prevArch && c < prevArch->chunks.size() ? &prevArch->chunks[c] : nullptr;
+                const bool moved = !before || chunk.structureTick > prev->tick;
+                structural |= moved;
+                out.entities = moved ? std::make_shared<const std::vector<EntityId>>(chunk.entities) : before->entities;
+                out.columns.resize(arch.infos.size());
+                if (key) key->columns[a][c].resize(arch.infos.size());
+
+                for (size_t col = 0; col < arch.infos.size(); ++col) {
+                    if (!moved && chunk.columnTicks[col] <= prev->tick) {
+                        out.columns[col] = before->columns[col];
+                    } else {
+                        jobs.push_back({&arch, a, c, col, &out.columns[col], key ? &key->columns[a][c][col] : nullptr});
+                    }
+                }
+            }
+        }
+
+        const Keyframe* base = key ? nullptr : prev->keyframe.get();
+        pool.parallelFor(jobs.size(), kEncodeGrain, [&](size_t begin, size_t end) {
+            thread_local Bytes code;
+            thread_local std::string image;
+            for (size_t j = begin; j < end; ++j) {
+                const EncodeJob& job = jobs[j];
+                auto [data, bytes] = columnImage(*job.arch, job.chunk, job.column, image);
+                if (job.keyImage) {
+                    job.keyImage->assign(data, data + bytes);
+                    auto empty = std::make_shared<Delta>();
+                    empty->bytes = bytes;
+                    *job.out = std::move(empty);
+                } else {
+                    *job.out = encode(data, bytes, base->image(job.archetype, job.chunk, job.column), code);
+                }
+            }
+        });
+
+        for (const ArchetypeState& state : frame.archetypes) {
+            for (const ChunkState& chunk : state.chunks) {
+                for (const auto& column : chunk.columns) frame.deltaBytes += column->code.size();
+            }
+        }
+        if (key) {
+            for (const auto& chunks : key->columns) {
+                for (const auto& columns : chunks) {
+                    for (const Bytes& image : columns) key->bytes += image.size();
+                }
+            }
+            frame.keyframe = std::move(key);
+        } else {
+            frame.keyframe = prev->keyframe;
+        }
+        if (structural) {
+            frame.generations = std::make_shared<const std::vector<uint32_t>>(world.registry.generationList());
+            frame.freeSlots = std::make_shared<const std::vector<uint32_t>>(world.registry.freeSlots());
+        } else {
+            frame.generations = prev->generations;
+            frame.freeSlots = prev->freeSlots;
+        }
+
+        frames.push_back(std::move(frame));
+        if (frames.size() > capacity) frames.pop_front();
+        forceFull = false;
+        world.advanceTick();
+    }
+
+    // framesBack = 0 -> frame terakhir yang di-capture. Semua komponen yang dipulihkan dianggap berubah
+    // (changed-system dan hierarki melihatnya). Frame yang lebih baru tetap ada di ring.
+    void restore(ArchetypeWorld& world, size_t framesBack = 0) {
+        if (framesBack >= frames.size()) throw std::runtime_error("Frame is no longer in rollback history");
+        for (auto& sparse : world.sparsePools) {
+            if (sparse && sparse->size() > 0) throw std::runtime_error("Sparse components are not part of rollback history");
+        }
+        const Frame& frame = frames[frames.size() - 1 - framesBack];
+        const Keyframe& key = *frame.keyframe;
+        const uint32_t tick = world.currentTick();
+
+        // Blok chunk lama dipakai ulang; isinya di-destroy dulu karena akan ditimpa
+        for (auto& arch : world.archetypes) {
+            for (size_t c = 0; c < arch->chunks.size(); ++c) {
+                for (size_t row = 0; row < arch->chunks[c].entities.size(); ++row) arch->destroyRow(c, row);
+                arch->chunks[c].entities.clear();
+            }
+        }
+
+        world.locations.assign(frame.generations->size(), {});
+        std::vector<bool> restored(world.archetypes.size(), false);
+        for (size_t a = 0; a < frame.archetypes.size(); ++a) {
+            const ArchetypeState& state = frame.archetypes[a];
+            const uint32_t archIndex = world.findOrCreateArchetype(state.mask);
+            Archetype& arch = *world.archetypes[archIndex];
+            restored.resize(world.archetypes.size(), false);
+            restored[archIndex] = true;
+            if (arch.chunks.size() > state.chunks.size()) arch.chunks.resize(state.chunks.size());
+            while (arch.chunks.size() < state.chunks.size()) arch.appendChunk();
+
+            for (size_t c = 0; c < state.chunks.size(); ++c) {
+                ArchetypeChunk& chunk = arch.chunks[c];
+                const ChunkState& saved = state.chunks[c];
+                chunk.entities = *saved.entities;
+                for (size_t col = 0; col < arch.infos.size(); ++col) {
+                    const ComponentInfo& info = *arch.infos[col];
+                    const Delta& delta = *saved.columns[col];
+                    const Bytes* base = key.image(a, c, col);
+                    if (info.triviallyRelocatable) {
+                        decode(delta, base, reinterpret_cast<uint8_t*>(arch.cell(c, col, 0)));
+                    } else {
+                        decoded.resize(delta.bytes);
+                        decode(delta, base, decoded.data());
+                        ByteReader in(decoded.data(), decoded.size());
+                        for (size_t row = 0; row < chunk.entities.size(); ++row) info.deserialize(arch.cell(c, col, row), in);
+                    }
+                }
+                std::fill(chunk.rowTicks.begin(), chunk.rowTicks.end(), 0);
+                std::fill(chunk.columnTicks.begin(), chunk.columnTicks.end(), tick);
+                std::fill(chunk.wholeColumnTicks.begin(), chunk.wholeColumnTicks.end(), tick);
+                chunk.structureTick = tick;
+                for (size_t row = 0; row < chunk.entities.size(); ++row) {
+                    world.locations[chunk.entities[row]] = {archIndex, uint32_t(c), uint32_t(row)};
+                }
+            }
+        }
+        for (size_t a = 0; a < world.archetypes.size(); ++a) {
+            if (!restored[a]) world.archetypes[a]->chunks.clear();
+        }
+        world.registry.restore(*frame.generations, *frame.freeSlots);
+        forceFull = true;
+    }
+};
+
+// =================================================================
+// 16. FRAME PACING (Fixed Timestep + Render Interpolation)
+// =================================================================
+
+inline void cpuRelax() {
+#if defined(__SSE2__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+struct FramePacerSettings {
+    double simulationHz = 60.0;
+    double targetFps = 60.0;  // <= 0: tidak menunggu sama sekali (benchmark / vsync dari luar)
+    int maxStepsPerFrame = 5; // batas catch-up; waktu di atasnya dibuang supaya tidak masuk spiral of death
+    double minSpinMs = 0.2;   // sisa waktu minimum sebelum deadline yang selalu di-spin, bukan di-sleep
+};
+
+struct FramePacingStats {
+    size_t frames = 0;
+    double meanFrameMs = 0;
+    double jitterMs = 0;        // standar deviasi interval antar awal frame
+    double p99DeviationMs = 0;  // |interval - periode target|, persentil 99
+    double maxDeviationMs = 0;
+    double meanWakeErrorMs = 0; // seberapa telat bangun dari deadline
+    size_t missedDeadlines = 0; // frame yang sudah lewat deadline sebelum sempat menunggu
+    double droppedSimMs = 0;    // waktu simulasi yang dibuang oleh batas catch-up
+};
+
+// Simulasi maju dengan step tetap dari accumulator waktu nyata (steady_clock, integer tick sehingga tidak
+// drift); render memakai alpha = sisa accumulator / step untuk interpolasi antar dua state simulasi.
+// Deadline frame absolut (deadline += periode), jadi keterlambatan satu frame tidak menggeser frame berikutnya.
+// Menunggu = sleep_for sampai sisa waktu tinggal `slack`, lalu spin; slack mengikuti keterlambatan sleep
+// yang teramati (rata-rata + 4x deviasi, seperti estimator RTT).
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    static constexpr size_t kIntervalHistory = 1024;
+
+    FramePacerSettings settings;
+    Clock::duration step;
+    Clock::duration period;
+    Clock::duration accumulator{0};
+    Clock::time_point lastBegin;
+    Clock::time_point deadline;
+    bool started = false;
+
+    double oversleepMeanMs = 0.5;
+    double oversleepDevMs = 0.25;
+
+    std::vector<double> intervalsMs; // ring, kIntervalHistory sampel terakhir
+    size_t intervalCursor = 0;
+    size_t frames = 0;
+    size_t waits = 0;
+    double wakeErrorMs = 0;
+    size_t missed = 0;
+    Clock::duration dropped{0};
+
+    static double toMs(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+    static Clock::duration fromSeconds(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    Clock::duration spinSlack() const {
+        const double ms = std::clamp(oversleepMeanMs + 4.0 * oversleepDevMs, settings.minSpinMs, 4.0);
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+    }
+
+    void observeOversleep(double lateMs) {
+        const double error = lateMs - oversleepMeanMs;
+        oversleepMeanMs += 0.125 * error;
+        oversleepDevMs += 0.25 * (std::abs(error) - oversleepDevMs);
+    }
+
+    void waitUntil(Clock::time_point target) {
+        for (;;) {
+            const auto now = Clock::now();
+            const auto remaining = target - now;
+            const auto slack = spinSlack();
+            if (remaining <= slack) break;
+            const auto request = remaining - slack;
+            std::this_thread::sleep_for(request);
+            observeOversleep(toMs((Clock::now() - now) - request));
+        }
+        while (Clock::now() < target) cpuRelax();
+    }
+
+public:
+    explicit FramePacer(FramePacerSettings s = {})
+        : settings(s), step(fromSeconds(1.0 / s.simulationHz)),
+          period(s.targetFps > 0 ? fromSeconds(1.0 / s.targetFps) : Clock::duration::zero()) {}
+
+    double stepSeconds() const { return std::chrono::duration<double>(step).count(); }
+
+    // Mengembalikan jumlah step simulasi yang harus dijalankan frame ini. Frame pertama menjalankan satu
+    // step supaya selalu ada state untuk dirender.
+    int beginFrame() {
+        const auto now = Clock::now();
+        if (!started) {
+            started = true;
+            accumulator = step;
+            deadline = now + period;
+        } else {
+            const auto elapsed = now - lastBegin;
+            accumulator += elapsed;
+            if (intervalsMs.size() < kIntervalHistory) {
+                intervalsMs.push_back(toMs(elapsed));
+            } else {
+                intervalsMs[intervalCursor] = toMs(elapsed);
+                intervalCursor = (intervalCursor + 1) % kIntervalHistory;
+            }
+        }
+        lastBegin = now;
+        ++frames;
+
+        int steps = int(accumulator / step);
+        if (steps > settings.maxStepsPerFrame) {
+            dropped += (steps - settings.maxStepsPerFrame) * step;
+            accumulator -= (steps - settings.maxStepsPerFrame) * step;
+            steps = settings.maxStepsPerFrame;
+        }
+        accumulator -= steps * step;
+        return steps;
+    }
+
+    // Posisi render di antara state simulasi sebelumnya (0) dan terbaru (1)
+    double alpha() const { return double(accumulator.count()) / double(step.count()); }
+
+    // Tunggu sampai deadline frame berikutnya. Terlambat lebih dari satu periode -> jadwal dimulai ulang dari
+    // sekarang, bukan dikejar dengan beberapa frame tanpa jeda.
+    void endFrame() {
+        if (period == Clock::duration::zero()) return;
+        const auto now = Clock::now();
+        if (now >= deadline) {
+            ++missed;
+            deadline = now - deadline > period ? now + period : deadline + period;
+            return;
+        }
+        waitUntil(deadline);
+        wakeErrorMs += toMs(Clock::now() - deadline);
+        ++waits;
+        deadline += period;
+    }
+
+    FramePacingStats stats() const {
+        FramePacingStats s;
+        s.frames = frames;
+        s.missedDeadlines = missed;
+        s.droppedSimMs = toMs(dropped);
+        s.meanWakeErrorMs = waits ? wakeErrorMs / double(waits) : 0.0;
+        if (intervalsMs.empty()) return s;
+
+        const double n = double(intervalsMs.size());
+        double sum = 0, sumSq = 0;
+        for (double ms : intervalsMs) {
+            sum += ms;
+            sumSq += ms * ms;
+        }
+        s.meanFrameMs = sum / n;
+        s.jitterMs = std::sqrt(std::max(0.0, sumSq / n - s.meanFrameMs * s.meanFrameMs));
+
+        const double target = period == Clock::duration::zero() ? s.meanFrameMs : toMs(period);
+        std::vector<double> deviation;
+        deviation.reserve(intervalsMs.size());
+        for (double ms : intervalsMs) deviation.push_back(std::abs(ms - target));
+        const size_t p99 = std::min(deviation.size() - 1, size_t(std::ceil(0.99 * n)) - 1);
+        std::nth_element(deviation.begin(), deviation.begin() + p99, deviation.end());
+        s.p99DeviationMs = deviation[p99];
+        s.maxDeviationMs = *std::max_element(deviation.begin(), deviation.end());
+        return s;
+    }
+};
+
+// Pose Transform pada dua step simulasi terakhir, diindeks EntityHandle::index. Hanya Transform yang berubah
+// (change tick) yang disalin; entity yang berhenti bergerak disamakan previous = current satu step kemudian.
+class TransformInterpolator {
+public:
+    struct Pose {
+        Engine::Math::Vector3 position;
+        Engine::Math::Vector3 rotation;
+    };
+
+private:
+    std::vector<Pose> previous;
+    std::vector<Pose> current;
+    std::vector<EntityHandle> owners; // entity pemilik slot saat pose dicatat
+    std::vector<uint32_t> moved;      // slot yang berubah di step terakhir
+    uint32_t lastTick = 0;
+
+public:
+    // Dipanggil setelah setiap step simulasi
+    void capture(ArchetypeWorld& world) {
+        const uint32_t since = lastTick;
+        lastTick = world.currentTick();
+        for (uint32_t i : moved) previous[i] = current[i];
+        moved.clear();
+        world.eachChangedEntity<TransformComponent>(since, [&](EntityHandle h) {
+            if (h.index >= owners.size()) {
+                previous.resize(h.index + 1);
+                current.resize(h.index + 1);
+                owners.resize(h.index + 1);
+            }
+            const TransformComponent& t = *world.getComponent<const TransformComponent>(h);
+            current[h.index] = {t.position, t.rotation};
+            if (owners[h.index] != h) {
+                owners[h.index] = h;
+                previous[h.index] = current[h.index]; // entity baru: belum ada state sebelumnya
+            }
+            moved.push_back(h.index);
+        });
+        world.advanceTick(); // tulisan setelah ini harus lebih baru dari lastTick
+    }
+
+    // `now` dipakai jika entity belum pernah di-capture
+    Pose sample(EntityHandle h, const TransformComponent& now, double alpha) const {
+        if (h.index >= owners.size() || owners[h.index] != h) return {now.position, now.rotation};
+        const Pose& a = previous[h.index];
+        const Pose& b = current[h.index];
+        return {a.position + (b.position - a.position) * alpha, a.rotation + (b.rotation - a.rotation) * alpha};
+    }
+};
+
+// =================================================================
+// 17. SYSTEM SCHEDULER (Read/Write Dependency Graph)
+// =================================================================
+
+// Sistem mendeklarasikan komponen yang dibaca/ditulis; dua sistem konflik jika salah satu menulis
+// komponen yang disentuh yang lain. Sistem tanpa konflik berjalan bersamaan di WorkerPool.
+class SystemScheduler {
+public:
+    struct System {
+        std::string name;
+        ComponentMask reads;
+        ComponentMask writes;
+        std::function<void(ArchetypeWorld&, double)> run;
+        const char* profileName = nullptr; // nama zone profiler (di-intern sekali saat registrasi)
+    };
+
+private:
+    WorkerPool& pool;
+    std::vector<System> systems;
+
+    static bool conflicts(const System& a, const System& b) {
+        return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+    }
+
+public:
+    explicit SystemScheduler(WorkerPool& p = WorkerPool::getInstance()) : pool(p) {}
+
+    void addSystem(std::string name, ComponentMask reads, ComponentMask writes, std::function<void(ArchetypeWorld&, double)> run) {
+        const char* profileName = Profiler::getInstance().intern(name);
+        systems.push_back({std::move(name), reads, writes, std::move(run), profileName});
+    }
+
+    // Sistem per-entity: `const T` = read, `T` = write. Chunk yang cocok dibagi ke beberapa worker.
+    template <typename... Ts, typename Fn>
+    void addEachSystem(std::string name, Fn fn) {
+        static_assert(!(isSparseComponent<std::remove_const_t<Ts>> || ...), "each-system hanya untuk komponen table");
+        ComponentMask reads, writes;
+        ((std::is_const_v<Ts> ? reads : writes).set(componentTypeId<Ts>()), ...);
+        WorkerPool* p = &pool;
+        addSystem(std::move(name), reads, writes, [p, fn, query = ArchetypeWorld::query<Ts...>()](ArchetypeWorld& world, double dt) mutable {
+            const auto& chunks = world.chunksMatching(query);
+            p->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; ++c) {
+                    ArchetypeWorld::eachInChunk<Ts...>(chunks[c], [&](Ts&... components) { fn(dt, components...); });
+                }
+            });
+        });
+    }
+
+    // Seperti addEachSystem, tapi hanya mengunjungi entity yang komponen pertamanya berubah sejak sistem ini
+    // terakhir jalan. Biayanya sebanding dengan jumlah perubahan, bukan ukuran world.
+    template <typename... Ts, typename Fn>
+    void addChangedSystem(std::string name, Fn fn) {
+        static_assert(!(isSparseComponent<std::remove_const_t<Ts>> || ...), "changed-system hanya untuk komponen table");
+        ComponentMask reads, writes;
+        ((std::is_const_v<Ts> ? reads : writes).set(componentTypeId<Ts>()), ...);
+        WorkerPool* p = &pool;
+        addSystem(std::move(name), reads, writes,
+                  [p, fn, query = ArchetypeWorld::query<Ts...>(), lastRun = uint32_t(0)](ArchetypeWorld& world, double dt) mutable {
+            const uint32_t since = lastRun;
+            lastRun = world.currentTick();
+            const auto& chunks = world.chunksMatching(query);
+            p->parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; ++c) {
+                    ArchetypeWorld::eachChangedInChunk<Ts...>(chunks[c], since, [&](Ts&... components) { fn(dt, components...); });
+                }
+            });
+        });
+    }
+
+    size_t systemCount() const { return systems.size(); }
+
+    // DAG dibangun ulang setiap frame: edge i -> j jika i didaftarkan lebih dulu dan keduanya konflik
+    void run(ArchetypeWorld& world, double dt) {
+        const size_t n = systems.size();
+        if (n == 0) return;
+        if (n == 1 || pool.threadCount() == 1) {
+            for (auto& system : systems) {
+                ENGINE_PROFILE_ZONE(system.profileName);
+                system.run(world, dt);
+                world.advanceTick();
+            }
+            return;
+        }
+
+        // Graf per frame di scratch arena: successor sistem i = successors[first[i], first[i + 1])
+        ArenaScope scratch;
+        ArenaVector<size_t> first(n + 1, 0, scratch.allocator<size_t>());
+        ArenaVector<size_t> successors(scratch.allocator<size_t>());
+        ArenaVector<std::atomic<int>> dependencies(n, scratch.allocator<std::atomic<int>>());
+        for (size_t i = 0; i < n; ++i) {
+            first[i] = successors.size();
+            for (size_t j = i + 1; j < n; ++j) {
+                if (conflicts(systems[i], systems[j])) {
+                    successors.push_back(j);
+                    ++dependencies[j];
+                }
+            }
+        }
+        first[n] = successors.size();
+
+        std::atomic<size_t> remaining{n};
+        std::function<void(size_t)> launch = [&](size_t i) {
+            pool.submit([&, i] {
+                {
+                    ENGINE_PROFILE_ZONE(systems[i].profileName);
+                    systems[i].run(world, dt);
+                }
+                world.advanceTick();
+                for (size_t k = first[i]; k < first[i + 1]; ++k) {
+                    if (--dependencies[successors[k]] == 0) launch(successors[k]);
+                }
+                remaining.fetch_sub(1);
+            }, &remaining);
+        };
+        // Kumpulkan root dulu: begitu satu sistem jalan, counter sistem lain bisa turun ke 0 dan dieksekusi ganda
+        ArenaVector<size_t> roots(scratch.allocator<size_t>());
+        for (size_t i = 0; i < n; ++i) {
+            if (dependencies[i] == 0) roots.push_back(i);
+        }
+        for (size_t i : roots) launch(i);
+        pool.waitUntil(&remaining, [&] { return remaining.load() == 0; });
+    }
+};
+
+// =================================================================
+// 18. EVENTS (Hashed IDs, SBO Delegates, Deferred Queue, Signals)
+// =================================================================
+
+// ID event = hash FNV-1a 32-bit dari namanya; untuk literal dihitung saat kompilasi ("OnCrash"_event).
+// Nama ikut dibawa supaya tabrakan hash ketahuan saat subscribe, bukan diam-diam saat trigger.
+struct EventId {
+    uint32_t hash = 0;
+    std::string_view name;
+
+    static constexpr EventId of(std::string_view name) {
+        uint32_t h = 2166136261u;
+        for (char c : name) {
+            h ^= uint8_t(c);
+            h *= 16777619u;
+        }
+        return {h, name};
+    }
+};
+
+constexpr EventId operator""_event(const char* name, size_t length) { return EventId::of(std::string_view(name, length)); }
+
+template <typename Signature>
+class Delegate;
+
+// Pengganti std::function yang hanya bisa di-move: callable sampai 32 byte (lambda dengan beberapa capture,
+// function pointer, bahkan std::function) disimpan inline, jadi membuat dan memanggilnya tanpa alokasi.
+// Callable yang lebih besar atau move-nya bisa throw tetap didukung lewat heap.
+template <typename R, typename... Args>
+class Delegate<R(Args...)> {
+public:
+    static constexpr size_t kInlineBytes = 32;
+
+    template <typename F>
+    static constexpr bool storesInline = sizeof(F) <= kInlineBytes && alignof(F) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<F>;
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*relocate)(void* from, void* to) noexcept; // move-construct ke `to`, lalu hancurkan `from`
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    alignas(std::max_align_t) mutable std::byte storage[kInlineBytes];
+    const Ops* ops = nullptr;
+
+    template <typename F>
+    static F* target(void* storage) {
+        if constexpr (storesInline<F>) return std::launder(static_cast<F*>(storage));
+        else return *std::launder(static_cast<F**>(storage));
+    }
+
+    template <typename F>
+    static R invokeTarget(void* storage, Args&&... args) {
+        return (*target<F>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static void relocateTarget(void* from, void* to) noexcept {
+        if constexpr (storesInline<F>) {
+            F* f = target<F>(from);
+            ::new (to) F(std::move(*f));
+            f->~F();
+        } else {
+            ::new (to) F*(target<F>(from));
+        }
+    }
+
+    template <typename F>
+    static void destroyTarget(void* storage) noexcept {
+        if constexpr (storesInline<F>) target<F>(storage)->~F();
+        else delete target<F>(storage);
+    }
+
+    template <typename F>
+    static constexpr Ops kOps = {&invokeTarget<F>, &relocateTarget<F>, &destroyTarget<F>};
+
+    void moveFrom(Delegate& other) noexcept {
+        if (!other.ops) return;
+        other.ops->relocate(other.storage, storage);
+        ops = std::exchange(other.ops, nullptr);
+    }
+
+public:
+    Delegate() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate> &&
+                                                      std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    Delegate(F&& fn) {
+        using T = std::decay_t<F>;
+        if constexpr (storesInline<T>) ::new (static_cast<void*>(storage)) T(std::forward<F>(fn));
+        else ::new (static_cast<void*>(storage)) T*(new T(std::forward<F>(fn)));
+        ops = &kOps<T>;
+    }
+
+    Delegate(Delegate&& other) noexcept { moveFrom(other); }
+
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~Delegate() { reset(); }
+
+    void reset() noexcept {
+        if (ops) std::exchange(ops, nullptr)->destroy(storage);
+    }
+
+    explicit operator bool() const { return ops != nullptr; }
+
+    R operator()(Args... args) const { return ops->invoke(storage, std::forward<Args>(args)...); }
+};
+
+// Tabel dispatch datar: hash -> indeks channel lewat open addressing (linear probe, ukuran power of two),
+// tiap channel menyimpan subscriber-nya berurutan. trigger = satu probe + loop delegate: tanpa string compare,
+// tanpa alokasi. Subscribe/unsubscribe dari dalam callback aman; efeknya berlaku setelah dispatch selesai.
+// Tidak thread-safe: dipakai dari thread simulasi saja.
+class EventDispatcher {
+public:
+    using Callback = Delegate<void()>;
+
+    struct Subscription {
+        uint32_t channel = 0;
+        uint32_t token = 0; // 0 = null
+
+        bool isNull() const { return token == 0; }
+    };
+
+private:
+    static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t hash = 0;
+        uint32_t channel = kEmpty;
+    };
+
+    struct Subscriber {
+        uint32_t token; // 0 = sudah di-unsubscribe, dibuang setelah dispatch
+        Callback callback;
+    };
+
+    struct Channel {
+        std::string name;
+        std::vector<Subscriber> subscribers;
+        std::vector<Subscriber> pending; // subscribe selama dispatch
+        uint32_t dispatching = 0;
+        bool hasRemoved = false;
+    };
+
+    std::vector<Slot> table;
+    std::vector<Channel> channels;
+    uint32_t nextToken = 1;
+
+    uint32_t find(uint32_t hash) const {
+        if (table.empty()) return kEmpty;
+        const size_t mask = table.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot& slot = table[i];
+            if (slot.channel == kEmpty || slot.hash == hash) return slot.channel;
+        }
+    }
+
+    void insert(uint32_t hash, uint32_t channel) {
+        const size_t mask = table.size() - 1;
+        size_t i = hash & mask;
+        while (table[i].channel != kEmpty) i = (i + 1) & mask;
+        table[i] = {hash, channel};
+    }
+
+    uint32_t channelFor(EventId id) {
+        uint32_t c = find(id.hash);
+        if (c != kEmpty) {
+            if (channels[c].name != id.name) {
+                throw std::runtime_error("Event id collision: '" + std::string(id.name) + "' vs '" + channels[c].name + "'");
+            }
+            return c;
+        }
+        // Load factor <= 1/2 supaya probe tetap pendek
+        if ((channels.size() + 1) * 2 > table.size()) {
+            std::vector<Slot> old = std::exchange(table, std::vector<Slot>(std::max<size_t>(16, table.size() * 2)));
+            for (const Slot& slot : old) {
+                if (slot.channel != kEmpty) insert(slot.hash, slot.channel);
+            }
+        }
+        c = uint32_t(channels.size());
+        channels.push_back({std::string(id.name), {}, {}, 0, false});
+        insert(id.hash, c);
+        return c;
+    }
+
+    void settle(Channel& channel) {
+        if (channel.hasRemoved) {
+            auto& subs = channel.subscribers;
+            subs.erase(std::remove_if(subs.begin(), subs.end(), [](const Subscriber& s) { return s.token == 0; }), subs.end());
+            channel.hasRemoved = false;
+        }
+        for (Subscriber& s : channel.pending) channel.subscribers.push_back(std::move(s));
+        channel.pending.clear();
+    }
+
+public:
+    Subscription subscribe(EventId event, Callback callback) {
+        if (!callback) throw std::runtime_error("Empty event callback");
+        const uint32_t c = channelFor(event);
+        Channel& channel = channels[c];
+        const uint32_t token = nextToken++;
+        // Buffer subscribers tidak boleh berpindah selama ada dispatch yang sedang mengiterasinya
+        (channel.dispatching ? channel.pending : channel.subscribers).push_back({token, std::move(callback)});
+        return {c, token};
+    }
+
+    bool unsubscribe(Subscription subscription) {
+        if (subscription.isNull() || subscription.channel >= channels.size()) return false;
+        Channel& channel = channels[subscription.channel];
+        for (auto* list : {&channel.subscribers, &channel.pending}) {
+            for (auto it = list->begin(); it != list->end(); ++it) {
+                if (it->token != subscription.token) continue;
+                if (list == &channel.subscribers && channel.dispatching) {
+                    it->token = 0;
+                    channel.hasRemoved = true;
+                } else {
+                    list->erase(it);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void trigger(EventId event) {
+        const uint32_t c = find(event.hash);
+        if (c == kEmpty) return;
+
+        // Callback boleh subscribe ke event baru (channels bisa realokasi), jadi channel selalu diakses lewat indeks
+        struct DispatchScope {
+            EventDispatcher& owner;
+            uint32_t c;
+            ~DispatchScope() {
+                Channel& channel = owner.channels[c];
+                if (--channel.dispatching == 0) owner.settle(channel);
+            }
+        };
+        ++channels[c].dispatching;
+        DispatchScope scope{*this, c};
+        Subscriber* subs = channels[c].subscribers.data();
+        const size_t count = channels[c].subscribers.size();
+        for (size_t i = 0; i < count; ++i) {
+            if (subs[i].token) subs[i].callback();
+        }
+    }
+
+    size_t subscriberCount(EventId event) const {
+        const uint32_t c = find(event.hash);
+        if (c == kEmpty) return 0;
+        const auto& subs = channels[c].subscribers;
+        return size_t(std::count_if(subs.begin(), subs.end(), [](const Subscriber& s) { return s.token != 0; })) + channels[c].pending.size();
+    }
+};
+
+// Event bertipe yang di-publish dari thread mana pun lalu di-dispatch berkelompok di titik frame yang jelas
+// (SceneManager::update: setelah sistem & hierarki, sebelum capture interpolasi/rollback). Tiap thread menulis
+// ke buffer miliknya sendiri (mutex yang praktis tidak pernah direbut); dispatch() menukar buffer tulis/baca
+// semua thread, lalu memanggil handler per tipe: semua event satu tipe lewat satu handler sebelum handler
+// berikutnya, supaya kode dan datanya tetap di cache. Event yang di-publish dari dalam handler masuk batch
+// berikutnya. Urutan hanya dijamin per thread per tipe. Kapasitas buffer dipertahankan antar frame, jadi
+// setelah pemanasan publish tidak mengalokasi.
+class EventQueue {
+private:
+    using Buffers = std::vector<std::vector<std::byte>>; // diindeks typeIndex
+
+    struct ThreadQueue {
+        std::mutex mtx;
+        Buffers writing;
+        Buffers reading;
+    };
+
+    struct TypeSlot {
+        size_t (*dispatch)(void* handlers, const std::byte* events, size_t bytes) = nullptr;
+        std::shared_ptr<void> handlers; // std::vector<Delegate<void(const E&)>>
+    };
+
+    static inline std::atomic<uint32_t> nextType{0};
+    static inline std::atomic<uint64_t> nextId{1};
+    const uint64_t id = nextId.fetch_add(1);
+    const std::shared_ptr<const bool> alive = std::make_shared<const bool>(true); // lihat local()
+    std::mutex mtx; // registrasi thread
+    std::vector<std::unique_ptr<ThreadQueue>> threads;
+    std::vector<ThreadQueue*> draining;
+    std::vector<TypeSlot> types;
+    bool dispatching = false;
+
+    template <typename E>
+    static uint32_t typeIndex() {
+        static const uint32_t index = nextType.fetch_add(1);
+        return index;
+    }
+
+    template <typename E>
+    static size_t dispatchBatch(void* handlers, const std::byte* events, size_t bytes) {
+        const E* batch = reinterpret_cast<const E*>(events);
+        const size_t count = bytes / sizeof(E);
+        for (const auto& handler : *static_cast<std::vector<Delegate<void(const E&)>>*>(handlers)) {
+            for (size_t i = 0; i < count; ++i) handler(batch[i]);
+        }
+        return count;
+    }
+
+    // noinline: alamat thread_local tidak boleh di-cache melewati pergantian fiber. Seperti FrameArena::local,
+    // entri queue yang sudah dihancurkan dibuang saat cache miss
+    [[gnu::noinline]] ThreadQueue& local() {
+        struct CacheEntry {
+            uint64_t owner;
+            ThreadQueue* queue;
+            std::weak_ptr<const bool> alive;
+        };
+        thread_local std::vector<CacheEntry> cache;
+        for (const CacheEntry& entry : cache) {
+            if (entry.owner == id) return *entry.queue;
+        }
+        cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CacheEntry& e) { return e.alive.expired(); }), cache.end());
+        std::lock_guard<std::mutex> lock(mtx);
+        threads.push_back(std::make_unique<ThreadQueue>());
+        cache.push_back({id, threads.back().get(), alive});
+        return *threads.back();
+    }
+
+public:
+    EventQueue() = default;
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Handler didaftarkan dari thread yang memanggil dispatch(), di luar dispatch
+    template <typename E>
+    void subscribe(Delegate<void(const E&)> handler) {
+        if (dispatching) throw std::runtime_error("EventQueue::subscribe during dispatch");
+        if (!handler) throw std::runtime_error("Empty event handler");
+        const uint32_t t = typeIndex<E>();
+        if (types.size() <= t) types.resize(t + 1);
+        TypeSlot& slot = types[t];
+        if (!slot.handlers) {
+            slot.handlers = std::make_shared<std::vector<Delegate<void(const E&)>>>();
+            slot.dispatch = &dispatchBatch<E>;
+        }
+        static_cast<std::vector<Delegate<void(const E&)>>*>(slot.handlers.get())->push_back(std::move(handler));
+    }
+
+    // Payload disalin byte per byte ke buffer thread pemanggil
+    template <typename E>
+    void publish(const E& event) {
+        static_assert(std::is_trivially_copyable_v<E>, "Event payload harus trivially copyable");
+        static_assert(alignof(E) <= alignof(std::max_align_t), "Event payload over-aligned");
+        const uint32_t t = typeIndex<E>();
+        ThreadQueue& queue = local();
+        std::lock_guard<std::mutex> lock(queue.mtx);
+        if (queue.writing.size() <= t) queue.writing.resize(t + 1);
+        auto& bytes = queue.writing[t];
+        const size_t offset = bytes.size();
+        bytes.resize(offset + sizeof(E));
+        std::memcpy(bytes.data() + offset, &event, sizeof(E));
+    }
+
+    // Dipanggil satu thread saja (thread simulasi); mengembalikan jumlah event yang di-dispatch
+    size_t dispatch() {
+        if (dispatching) throw std::runtime_error("Recursive EventQueue::dispatch");
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            draining.clear();
+            for (auto& t : threads) draining.push_back(t.get());
+        }
+        size_t typeCount = 0;
+        for (ThreadQueue* queue : draining) {
+            std::lock_guard<std::mutex> lock(queue->mtx);
+            std::swap(queue->writing, queue->reading);
+            typeCount = std::max(typeCount, queue->reading.size());
+        }
+
+        // Buffer baca dikosongkan (kapasitas tetap) walaupun handler melempar exception
+        struct DrainScope {
+            EventQueue& owner;
+            ~DrainScope() {
+                for (ThreadQueue* queue : owner.draining) {
+                    for (auto& bytes : queue->reading) bytes.clear();
+                }
+                owner.dispatching = false;
+            }
+        };
+        dispatching = true;
+        DrainScope scope{*this};
+        size_t dispatched = 0;
+        for (uint32_t t = 0; t < typeCount; ++t) {
+            const TypeSlot* slot = t < types.size() && types[t].dispatch ? &types[t] : nullptr;
+            for (ThreadQueue* queue : draining) {
+                if (t >= queue->reading.size() || queue->reading[t].empty()) continue;
+                const auto& bytes = queue->reading[t];
+                if (slot) dispatched += slot->dispatch(slot->handlers.get(), bytes.data(), bytes.size());
+            }
+        }
+        return dispatched;
+    }
+};
+
+// Bagian Signal yang tidak bergantung pada tipe argumen. Connection memegangnya lewat weak_ptr, jadi
+// disconnect setelah Signal dihancurkan aman (no-op).
+//
+// Pembaca memakai RCU userspace yang dibagi semua Signal: tiap thread punya satu record berisi fase grace
+// period saat emit terluar dimulai (0 = tidak sedang emit). Masuk = satu store seq_cst ke record milik
+// sendiri (tanpa cache line bersama), keluar = satu store release. Penulis membalik bit fase dua kali dan
+// menunggu semua record yang masih di fase lama.
+class SignalCore {
+public:
+    struct ReaderRecord {
+        std::atomic<uint64_t> phase{0};
+        int nesting = 0;
+    };
+
+private:
+    static constexpr uint64_t kPhaseBit = 2; // bit 0 selalu 1 selama emit, supaya record aktif != 0
+    static inline std::atomic<uint64_t> gracePhase{1};
+    static inline std::mutex registryMtx;
+    static inline std::mutex graceMtx; // satu grace period pada satu waktu
+    static inline std::vector<std::shared_ptr<ReaderRecord>> registry; // shared: synchronize() bisa masih menunggu record thread yang sudah exit
+
+public:
+    virtual ~SignalCore() = default;
+    virtual bool disconnect(uint64_t slot) = 0;
+    virtual bool connected(uint64_t slot) = 0;
+
+    // Slot tidak boleh memarkir fiber: record ini milik thread, bukan fiber
+    static ReaderRecord& reader() {
+        struct Registration {
+            std::shared_ptr<ReaderRecord> record = std::make_shared<ReaderRecord>();
+            Registration() {
+                std::lock_guard<std::mutex> lock(registryMtx);
+                registry.push_back(record);
+            }
+            ~Registration() {
+                std::lock_guard<std::mutex> lock(registryMtx);
+                registry.erase(std::find(registry.begin(), registry.end(), record));
+            }
+        };
+        thread_local Registration registration;
+        return *registration.record;
+    }
+
+    static ReaderRecord& enterRead() {
+        ReaderRecord& r = reader();
+        if (r.nesting++ == 0) r.phase.store(gracePhase.load(std::memory_order_relaxed));
+        return r;
+    }
+
+    static void exitRead(ReaderRecord& r) {
+        if (--r.nesting == 0) r.phase.store(0, std::memory_order_release);
+    }
+
+    // Kembali setelah semua emit yang mungkin masih melihat daftar slot lama selesai.
+    // Tidak boleh dipanggil dari dalam emit (thread ini sendiri akan ditunggu).
+    // Menunggu di salinan registry tanpa registryMtx: thread yang baru emit pertama kali / sedang exit tidak
+    // boleh terblokir di belakang grace period (reader lama bisa saja sedang menunggu thread itu). Reader yang
+    // mendaftar setelah salinan dibuat sudah pasti melihat daftar slot baru.
+    static void synchronize() {
+        std::lock_guard<std::mutex> grace(graceMtx);
+        std::vector<std::shared_ptr<ReaderRecord>> readers;
+        {
+            std::lock_guard<std::mutex> lock(registryMtx);
+            readers = registry;
+        }
+        for (int round = 0; round < 2; ++round) {
+            const uint64_t current = gracePhase.fetch_xor(kPhaseBit) ^ kPhaseBit;
+            for (const auto& r : readers) {
+                for (;;) {
+                    const uint64_t phase = r->phase.load();
+                    if (phase == 0 || ((phase ^ current) & kPhaseBit) == 0) break;
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+};
+
+class Connection {
+private:
+    std::weak_ptr<SignalCore> core;
+    uint64_t slot = 0;
+
+public:
+    Connection() = default;
+    Connection(std::weak_ptr<SignalCore> c, uint64_t s) : core(std::move(c)), slot(s) {}
+
+    bool disconnect() {
+        auto c = core.lock();
+        core.reset();
+        return c && c->disconnect(slot);
+    }
+
+    bool connected() const {
+        auto c = core.lock();
+        return c && c->connected(slot);
+    }
+};
+
+// Putus otomatis saat keluar scope (mis. member objek yang mendengarkan signal)
+class ScopedConnection {
+private:
+    Connection connection;
+
+public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection c) : connection(std::move(c)) {}
+    ScopedConnection(ScopedConnection&& other) noexcept : connection(std::exchange(other.connection, {})) {}
+    ScopedConnection& operator=(ScopedConnection&& other) noexcept {
+        if (this != &other) {
+            connection.disconnect();
+            connection = std::exchange(other.connection, {});
+        }
+        return *this;
+    }
+    ~ScopedConnection() { connection.disconnect(); }
+
+    bool connected() const { return connection.connected(); }
+    Connection release() { return std::exchange(connection, {}); }
+};
+
+// Signal/slot ala Godot (hit, start_game, screen_exited). Daftar slot immutable dan diganti utuh saat
+// connect/disconnect (copy-on-write). emit() lock-free dari thread mana pun (lihat SignalCore); penulis
+// memasang daftar baru lalu menunggu grace period sebelum membebaskan daftar lama. Tanpa slot, emit hanya
+// satu load. connect/disconnect dari dalam slot aman; daftar lama baru dibebaskan oleh penulis berikutnya
+// di luar emit, atau oleh destructor. Signal tidak boleh dihancurkan selama masih ada emit berjalan.
+template <typename... Args>
+class Signal {
+public:
+    using Slot = Delegate<void(Args...)>;
+
+private:
+    struct SlotList {
+        std::vector<std::pair<uint64_t, std::shared_ptr<const Slot>>> slots;
+    };
+
+    struct Core final : SignalCore {
+        std::atomic<const SlotList*> current{nullptr};
+        std::mutex mtx; // penulis
+        std::vector<const SlotList*> retired;
+        uint64_t nextSlot = 1;
+
+        ~Core() override {
+            delete current.load();
+            for (const SlotList* list : retired) delete list;
+        }
+
+        // edit mengubah salinan daftar; false = tidak ada perubahan
+        template <typename Edit>
+        bool modify(Edit&& edit) {
+            std::vector<const SlotList*> reclaim;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                const SlotList* previous = current.load();
+                auto next = previous ? std::make_unique<SlotList>(*previous) : std::make_unique<SlotList>();
+                if (!edit(next->slots)) return false;
+                current.store(next->slots.empty() ? nullptr : next.release());
+                if (previous) retired.push_back(previous);
+                if (reader().nesting > 0) return true;
+                reclaim.swap(retired);
+            }
+            SignalCore::synchronize();
+            for (const SlotList* list : reclaim) delete list;
+            return true;
+        }
+
+        bool disconnect(uint64_t slot) override {
+            return modify([&](auto& slots) {
+                auto it = std::find_if(slots.begin(), slots.end(), [&](const auto& s) { return s.first == slot; });
+                if (it == slots.end()) return false;
+                slots.erase(it);
+                return true;
+            });
+        }
+
+        bool connected(uint64_t slot) override {
+            std::lock_guard<std::mutex> lock(mtx);
+            const SlotList* list = current.load();
+            return list && std::any_of(list->slots.begin(), list->slots.end(), [&](const auto& s) { return s.first == slot; });
+        }
+    };
+
+    std::shared_ptr<Core> core = std::make_shared<Core>();
+
+public:
+    Signal() = default;
+    Signal(const Signal&) = delete;
+    Signal& operator=(const Signal&) = delete;
+
+    Connection connect(Slot slot) {
+        if (!slot) throw std::runtime_error("Empty signal slot");
+        auto shared = std::make_shared<const Slot>(std::move(slot));
+        uint64_t id = 0;
+        core->modify([&](auto& slots) {
+            id = core->nextSlot++;
+            slots.emplace_back(id, shared);
+            return true;
+        });
+        return Connection(core, id);
+    }
+
+    void disconnectAll() {
+        core->modify([](auto& slots) {
+            slots.clear();
+            return true;
+        });
+    }
+
+    size_t slotCount() const {
+        std::lock_guard<std::mutex> lock(core->mtx);
+        const SlotList* list = core->current.load();
+        return list ? list->slots.size() : 0;
+    }
+
+    void emit(Args... args) const {
+        Core& c = *core;
+        if (!c.current.load(std::memory_order_relaxed)) return;
+
+        struct ReadScope {
+            SignalCore::ReaderRecord& record;
+            ~ReadScope() { SignalCore::exitRead(record); }
+        };
+        ReadScope scope{SignalCore::enterRead()};
+        if (const SlotList* list = c.current.load()) {
+            for (const auto& [id, slot] : list->slots) (*slot)(args...);
+        }
+    }
+};
+
+// =================================================================
+// 19. SCENE GRAPH & EVENT SYSTEM
+// =================================================================
+
+// Parent/child antar entity world (mis. MobSpawnLocation di bawah MobPath, sprite di bawah Player).
+// Transform lokal tetap di TransformComponent; matrix world disimpan di sini, diindeks EntityHandle::index.
+class TransformHierarchy {
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+private:
+    struct Node {
+        uint32_t generation = 0;
+        uint32_t parent = kNone;
+        uint32_t depth = 0;
+        bool present = false;
+        std::vector<uint32_t> children;
+    };
+
+    WorkerPool& pool;
+    std::vector<Node> nodes;
+    std::vector<Engine::Math::Matrix4x4> worldMatrices;
+    std::vector<uint32_t> visitEpoch;          // == epoch jika node sudah dihitung ulang di propagate ini
+    std::vector<uint32_t> pending;             // node baru / pindah parent, wajib dihitung ulang
+    std::vector<std::vector<uint32_t>> dirtyByDepth;
+    uint32_t epoch = 0;
+    uint32_t lastTick = 0;
+    size_t levelCount = 0;
+    size_t nodeCount = 0;
+    bool depthsDirty = false;
+
+    static constexpr size_t kPropagateGrain = 256;
+
+    bool contains(EntityHandle h) const {
+        return !h.isNull() && h.index < nodes.size() && nodes[h.index].present && nodes[h.index].generation == h.generation;
+    }
+
+    void unlink(uint32_t index) {
+        Node& n = nodes[index];
+        if (n.parent == kNone) return;
+        auto& siblings = nodes[n.parent].children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), index));
+        n.parent = kNone;
+    }
+
+    // Anak-anak node yang dihapus naik menjadi root
+    void removeNode(uint32_t index) {
+        unlink(index);
+        for (uint32_t child : nodes[index].children) {
+            nodes[child].parent = kNone;
+            pending.push_back(child);
+        }
+        nodes[index] = Node{};
+        --nodeCount;
+        depthsDirty = true;
+    }
+
+    void ensure(EntityHandle h) {
+        if (h.index >= nodes.size()) {
+            nodes.resize(h.index + 1);
+            worldMatrices.resize(h.index + 1, Engine::Math::Matrix4x4::Identity());
+            visitEpoch.resize(h.index + 1, 0);
+        }
+        if (contains(h)) return;
+        if (nodes[h.index].present) removeNode(h.index); // slot milik entity lama yang sudah mati
+        nodes[h.index].generation = h.generation;
+        nodes[h.index].present = true;
+        ++nodeCount;
+        pending.push_back(h.index);
+        depthsDirty = true;
+    }
+
+    // Kedalaman hanya dihitung ulang setelah perubahan struktur, bukan tiap frame
+    void rebuildDepths() {
+        ArenaScope scratch;
+        ArenaVector<uint32_t> frontier(scratch.allocator<uint32_t>()), next(scratch.allocator<uint32_t>());
+        for (uint32_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].present && nodes[i].parent == kNone) frontier.push_back(i);
+        }
+        levelCount = 0;
+        while (!frontier.empty()) {
+            next.clear();
+            for (uint32_t i : frontier) {
+                nodes[i].depth = uint32_t(levelCount);
+                next.insert(next.end(), nodes[i].children.begin(), nodes[i].children.end());
+            }
+            frontier.swap(next);
+            ++levelCount;
+        }
+        depthsDirty = false;
+    }
+
+public:
+    explicit TransformHierarchy(WorkerPool& p = WorkerPool::getInstance()) : pool(p) {}
+
+    // Parent null -> child menjadi root. Melempar jika parent adalah keturunan child.
+    void setParent(EntityHandle child, EntityHandle parent) {
+        ensure(child);
+        if (!parent.isNull()) {
+            ensure(parent);
+            for (uint32_t a = parent.index; a != kNone; a = nodes[a].parent) {
+                if (a == child.index) throw std::runtime_error("Hierarchy cycle");
+            }
+        }
+        unlink(child.index);
+        if (!parent.isNull()) {
+            nodes[parent.index].children.push_back(child.index);
+            nodes[child.index].parent = parent.index;
+        }
+        pending.push_back(child.index);
+        depthsDirty = true;
+    }
+
+    void remove(EntityHandle h) {
+        if (contains(h)) removeNode(h.index);
+    }
+
+    EntityHandle parentOf(EntityHandle h) const {
+        if (!contains(h) || nodes[h.index].parent == kNone) return {};
+        uint32_t p = nodes[h.index].parent;
+        return {p, nodes[p].generation};
+    }
+
+    // h beserta seluruh keturunannya, parent selalu sebelum anaknya
+    void collectSubtree(EntityHandle h, std::vector<EntityHandle>& out) const {
+        if (!contains(h)) return;
+        size_t first = out.size();
+        out.push_back(h);
+        for (size_t k = first; k < out.size(); ++k) {
+            for (uint32_t child : nodes[out[k].index].children) out.push_back({child, nodes[child].generation});
+        }
+    }
+
+    const Engine::Math::Matrix4x4* worldMatrix(EntityHandle h) const { return contains(h) ? &worldMatrices[h.index] : nullptr; }
+
+    size_t size() const { return nodeCount; }
+
+    size_t depth() {
+        if (depthsDirty) rebuildDepths();
+        return levelCount;
+    }
+
+    // Node yang dihitung ulang: Transform-nya berubah sejak propagate sebelumnya, baru dipasang, atau parent-nya
+    // ikut dihitung ulang. Diproses per level kedalaman (BFS); node satu level saling independen sehingga
+    // dikerjakan paralel, dan subtree yang bersih tidak disentuh sama sekali. Mengembalikan jumlah node.
+    size_t propagate(ArchetypeWorld& world) {
+        using Engine::Math::Matrix4x4;
+        if (depthsDirty) rebuildDepths();
+        const uint32_t since = lastTick;
+        lastTick = world.currentTick();
+        ++epoch;
+
+        dirtyByDepth.resize(levelCount);
+        for (auto& level : dirtyByDepth) level.clear();
+        for (uint32_t i : pending) {
+            if (nodes[i].present) dirtyByDepth[nodes[i].depth].push_back(i);
+        }
+        pending.clear();
+        if (nodeCount * 4 < world.entityCount()) {
+            // Hierarki kecil di world besar: cek tick per node lebih murah daripada memindai semua Transform yang berubah
+            for (uint32_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i].present && world.changeTickOf<TransformComponent>({i, nodes[i].generation}) > since) {
+                    dirtyByDepth[nodes[i].depth].push_back(i);
+                }
+            }
+        } else {
+            world.eachChangedEntity<TransformComponent>(since, [&](EntityHandle h) {
+                if (contains(h)) dirtyByDepth[nodes[h.index].depth].push_back(h.index);
+            });
+        }
+
+        size_t recomputed = 0;
+        ArenaScope scratch;
+        ArenaVector<uint32_t> current(scratch.allocator<uint32_t>()), next(scratch.allocator<uint32_t>());
+        for (size_t d = 0; d < levelCount; ++d) {
+            // Gabungkan node kotor di level ini dengan anak-anak node yang baru dihitung ulang; buang duplikat
+            current.clear();
+            auto gather = [&](const auto& source) {
+                for (uint32_t i : source) {
+                    if (visitEpoch[i] == epoch) continue;
+                    visitEpoch[i] = epoch;
+                    current.push_back(i);
+                }
+            };
+            gather(dirtyByDepth[d]);
+            gather(next);
+            pool.parallelFor(current.size(), kPropagateGrain, [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    const uint32_t i = current[k];
+                    const Node& n = nodes[i];
+                    Matrix4x4 local = Matrix4x4::Identity();
+                    if (const auto* t = world.getComponent<const TransformComponent>({i, n.generation})) {
+                        local = Matrix4x4::TRS(t->position, t->rotation);
+                    }
+                    worldMatrices[i] = n.parent == kNone ? local : worldMatrices[n.parent] * local;
+                }
+            });
+            recomputed += current.size();
+            next.clear();
+            for (uint32_t i : current) next.insert(next.end(), nodes[i].children.begin(), nodes[i].children.end());
+        }
+        world.advanceTick(); // tulisan setelah ini harus lebih baru dari lastTick
+        return recomputed;
+    }
+};
+
+class SceneManager {
+private:
+    std::vector<std::shared_ptr<Entity>> entities;
+    size_t nextEntityId = 0; // id entity legacy tidak pernah dipakai ulang
+    EventDispatcher events;
+    EventQueue eventQueue;
+    Signal<EntityHandle> despawnedSignal;
+    ArchetypeWorld world;
+    WorkerPool& pool;
+    SystemScheduler scheduler;
+    TransformHierarchy hierarchy;
+    std::unique_ptr<WorldHistory> history;
+    std::unique_ptr<TransformInterpolator> interpolation;
+    bool parallelUpdate = false;
+    uint32_t randomSeed = 0x5EED5EEDu;
+    uint32_t simulationStep = 0;    // naik satu per update()
+    uint32_t lastCaptureStep = 0;   // simulationStep setelah capture rollback terakhir
+
+    // ~512 entity per chunk: pointer, Entity, dan dua komponennya kira-kira muat di separuh L2
+    static constexpr size_t kUpdateChunkEntities = 512;
+
+public:
+    explicit SceneManager(WorkerPool& p = WorkerPool::getInstance()) : pool(p), scheduler(p), hierarchy(p) {
+        // Sistem bawaan: sama dengan TransformComponent::update, tapi linear per kolom dan tanpa virtual call
+        scheduler.addEachSystem<TransformComponent>("Transform", [](double dt, TransformComponent& t) { t.update(dt); });
+        // getWorld().destroyEntity tidak lewat despawn: node-nya tetap dibuang (anak-anaknya menjadi root)
+        world.onDestroy([this](EntityHandle h) { hierarchy.remove(h); });
+    }
+
+    SystemScheduler& getScheduler() { return scheduler; }
+
+    ArchetypeWorld& getWorld() { return world; }
+    const ArchetypeWorld& getWorld() const { return world; }
+
+    // Entity baru selalu lewat registry world: id tidak lagi dipilih pemanggil dan bisa dihapus kembali
+    template <typename... Ts>
+    EntityHandle spawn(Ts&&... components) {
+        return world.createEntity(std::forward<Ts>(components)...);
+    }
+
+    // Batch spawn dari prefab (mis. gelombang mob); lihat ArchetypeWorld::instantiate
+    template <typename... Ts, typename Fn>
+    void instantiate(const Prefab& prefab, size_t count, std::vector<EntityHandle>& out, Fn&& init) {
+        world.instantiate<Ts...>(prefab, count, out, std::forward<Fn>(init));
+    }
+
+    std::vector<EntityHandle> instantiate(const Prefab& prefab, size_t count) {
+        std::vector<EntityHandle> handles;
+        world.instantiate(prefab, count, handles);
+        return handles;
+    }
+
+    // Seperti queue_free di Godot: anak-anaknya ikut dihapus
+    bool despawn(EntityHandle h) {
+        if (!world.isAlive(h)) return false;
+        std::vector<EntityHandle> subtree;
+        hierarchy.collectSubtree(h, subtree);
+        if (subtree.empty()) subtree.push_back(h);
+        for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+            despawnedSignal.emit(*it); // entity masih hidup selama slot berjalan
+            hierarchy.remove(*it);
+            world.destroyEntity(*it);
+        }
+        return true;
+    }
+
+    void setParent(EntityHandle child, EntityHandle parent) {
+        if (!world.isAlive(child) || (!parent.isNull() && !world.isAlive(parent))) throw std::runtime_error("Stale entity handle");
+        hierarchy.setParent(child, parent);
+    }
+
+    TransformHierarchy& getHierarchy() { return hierarchy; }
+
+    // Snapshot hanya berisi ECS world; hierarki dan entity legacy tidak ikut
+    void saveWorld(const std::string& path) { WorldSnapshot::save(world, path); }
+    // Tipe bawaan scene selalu didaftarkan dulu; tipe game lain yang mungkin ada di file lewat Ts
+    template <typename... Ts>
+    void loadWorld(const std::string& path) {
+        registerComponentTypes<TransformComponent, MeshComponent, Ts...>();
+        WorldSnapshot::load(world, path);
+    }
+
+    // Rollback: world di-capture di akhir setiap update; hierarki parent/child tidak ikut di-rewind
+    void enableRollback(size_t frames) { history = std::make_unique<WorldHistory>(frames); }
+    WorldHistory* getHistory() { return history.get(); }
+
+    // Step ikut mundur supaya simulasi ulang menarik angka acak yang sama
+    void rewind(size_t framesBack) {
+        if (!history) throw std::runtime_error("Rollback history is not enabled");
+        history->restore(world, framesBack);
+        simulationStep = lastCaptureStep - uint32_t(framesBack);
+    }
+
+    // Pose Transform dua step terakhir untuk render interpolasi; nullptr jika tidak diaktifkan
+    void setRenderInterpolation(bool enabled) {
+        interpolation = enabled ? std::make_unique<TransformInterpolator>() : nullptr;
+    }
+    const TransformInterpolator* getInterpolation() const { return interpolation.get(); }
+
+    // Sistem tanpa deklarasi akses dianggap menulis semua komponen, jadi selalu berjalan sendirian
+    void addSystem(std::function<void(ArchetypeWorld&, double)> system) {
+        scheduler.addSystem("custom", ComponentMask{}, ComponentMask{}.set(), std::move(system));
+    }
+
+    // Id entity legacy selalu dari scene supaya unik; komponen ditambahkan pemanggil lewat pointer hasilnya
+    std::shared_ptr<Entity> createEntity() {
+        entities.push_back(std::make_shared<Entity>(nextEntityId++));
+        return entities.back();
+    }
+
+    // Urutan entity lain tetap (update serial dan paralel memakai urutan yang sama); false jika id tidak ada
+    bool removeEntity(size_t id) {
+        auto it = std::find_if(entities.begin(), entities.end(), [&](const auto& e) { return e->getId() == id; });
+        if (it == entities.end()) return false;
+        entities.erase(it);
+        return true;
+    }
+
+    const std::vector<std::shared_ptr<Entity>>& getEntities() const { return entities; }
+
+    // Satu event bisa punya banyak subscriber; Subscription dipakai untuk melepasnya lagi
+    EventDispatcher::Subscription onEvent(EventId event, EventDispatcher::Callback callback) {
+        return events.subscribe(event, std::move(callback));
+    }
+    EventDispatcher::Subscription onEvent(std::string_view eventName, EventDispatcher::Callback callback) {
+        return events.subscribe(EventId::of(eventName), std::move(callback));
+    }
+
+    void triggerEvent(EventId event) { events.trigger(event); }
+    void triggerEvent(std::string_view eventName) { events.trigger(EventId::of(eventName)); }
+
+    EventDispatcher& getEvents() { return events; }
+
+    // Event tertunda: publish dari thread mana pun, handler jalan di update() setelah hierarki dipropagasi
+    EventQueue& getEventQueue() { return eventQueue; }
+
+    // Seperti signal tree_exiting di Godot: sekali per entity yang dihapus despawn(), anak lebih dulu
+    Signal<EntityHandle>& despawned() { return despawnedSignal; }
+
+    // Mode paralel mensyaratkan Component::update hanya menyentuh data entity-nya sendiri
+    // (benar untuk Transform/Mesh); hasilnya identik dengan mode serial berapa pun jumlah thread-nya.
+    void setParallelUpdate(bool enabled) { parallelUpdate = enabled; }
+
+    // Angka acak untuk sistem: stream per (seed, stream, entity, step), tanpa state bersama. Aman dibuat dari job
+    // paralel dan hasilnya sama berapa pun jumlah thread-nya; stream = id tetap per sistem/pemakaian.
+    Random::CounterRng random(uint32_t stream, EntityHandle entity = {}) const {
+        return Random::CounterRng(randomSeed, stream, entity.bits(), simulationStep);
+    }
+    void setRandomSeed(uint32_t seed) { randomSeed = seed; }
+    uint32_t currentStep() const { return simulationStep; }
+
+    void update(double dt) {
+        ENGINE_PROFILE_ZONE("SceneManager::update");
+        {
+            ENGINE_PROFILE_ZONE("Legacy Entities");
+            if (parallelUpdate) {
+                pool.parallelFor(entities.size(), kUpdateChunkEntities, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) entities[i]->update(dt);
+                });
+            } else {
+                for (auto& entity : entities) {
+                    entity->update(dt);
+                }
+            }
+        }
+        {
+            ENGINE_PROFILE_ZONE("Systems");
+            scheduler.run(world, dt);
+        }
+        {
+            ENGINE_PROFILE_ZONE("Hierarchy");
+            hierarchy.propagate(world);
+        }
+        {
+            ENGINE_PROFILE_ZONE("Events");
+            eventQueue.dispatch();
+        }
+        ++simulationStep;
+        if (interpolation) {
+            ENGINE_PROFILE_ZONE("Interpolation Capture");
+            interpolation->capture(world);
+        }
+        if (history) {
+            ENGINE_PROFILE_ZONE("Rollback Capture");
+            history->capture(world);
+            lastCaptureStep = simulationStep;
+        }
+        ENGINE_PROFILE_COUNTER("Entities", world.entityCount());
+    }
+};
+
+// =================================================================
+// 20. PATH TRACING RENDER MODE (BVH4)
+// =================================================================
+
+struct TracePrimitive {
+    float center[3];
+    float radius;
+    Engine::Math::Vector3 albedo;
+    Engine::Math::Vector3 emission;
+};
+
+// BVH dengan 4 anak per node; bounding box anak disimpan SoA supaya 1 ray vs 4 box = satu instruksi SSE
+class Bvh4 {
+public:
+    struct alignas(16) Node {
+        float bounds[6][4]; // minX, minY, minZ, maxX, maxY, maxZ untuk 4 anak
+        int32_t child[4];   // inner: index node (> 0), leaf: ~firstPrimitive, kosong: -1
+        uint32_t count[4];  // jumlah primitive di leaf, 0 untuk inner / slot kosong
+    };
+
+    static constexpr size_t kLeafSize = 2;
+
+    // Stack traversal: node inner di kedalaman d menyisakan <= 3 saudara per leluhur + 4 anak. Split median
+    // membagi ~4 per level, jadi 20 level sudah jauh di atas batas index int32.
+    static constexpr int kStackSize = 64;
+    static constexpr int kMaxDepth = 20;
+    static_assert(3 * kMaxDepth + 4 <= kStackSize, "BVH traversal stack too small for kMaxDepth");
+
+    // Primitive di-reorder supaya setiap leaf menunjuk ke range yang berurutan
+    void build(std::vector<TracePrimitive>& prims) {
+        nodes.clear();
+        primitives = &prims;
+        if (!prims.empty()) buildNode(prims, 0, prims.size(), 0);
+    }
+
+    bool intersect(const Engine::Math::Vector3& origin, const Engine::Math::Vector3& dir, float& tMax, uint32_t& primId) const {
+        if (nodes.empty()) return false;
+        const float o[3] = {float(origin.x), float(origin.y), float(origin.z)};
+        const float d[3] = {float(dir.x), float(dir.y), float(dir.z)};
+        float inv[3];
+        for (int a = 0; a < 3; ++a) inv[a] = 1.0f / (std::abs(d[a]) > 1e-12f ? d[a] : 1e-12f);
+
+        const auto& prims = *primitives;
+        bool hit = false;
+        int32_t stack[kStackSize];
+        int sp = 0;
+        stack[sp++] = 0;
+        while (sp > 0) {
+            const Node& node = nodes[stack[--sp]];
+            int mask = slabTest(node, o, inv, tMax);
+            while (mask) {
+                int lane = __builtin_ctz(mask);
+                mask &= mask - 1;
+                if (node.count[lane] == 0) {
+                    if (node.child[lane] > 0) stack[sp++] = node.child[lane]; // slot kosong: child == -1
+                    continue;
+                }
+                uint32_t first = uint32_t(~node.child[lane]);
+                for (uint32_t p = first; p < first + node.count[lane]; ++p) {
+                    if (intersectSphere(prims[p], o, d, tMax)) {
+                        primId = p;
+                        hit = true;
+                    }
+                }
+            }
+        }
+        return hit;
+    }
+
+private:
+    std::vector<Node> nodes;
+    const std::vector<TracePrimitive>* primitives = nullptr;
+
+    static bool intersectSphere(const TracePrimitive& s, const float o[3], const float d[3], float& tMax) {
+        float oc[3] = {o[0] - s.center[0], o[1] - s.center[1], o[2] - s.center[2]};
+        float b = oc[0] * d[0] + oc[1] * d[1] + oc[2] * d[2];
+        float c = oc[0] * oc[0] + oc[1] * oc[1] + oc[2] * oc[2] - s.radius * s.radius;
+        float disc = b * b - c;
+        if (disc < 0) return false;
+        float sq = std::sqrt(disc);
+        float t = -b - sq;
+        if (t < 1e-4f) t = -b + sq;
+        if (t < 1e-4f || t >= tMax) return false;
+        tMax = t;
+        return true;
+    }
+
+    static int slabTest(const Node& n, const float o[3], const float inv[3], float tMax) {
+#if defined(__SSE2__)
+        __m128 tNear = _mm_set1_ps(1e-4f), tFar = _mm_set1_ps(tMax);
+        for (int a = 0; a < 3; ++a) {
+            __m128 vo = _mm_set1_ps(o[a]), vi = _mm_set1_ps(inv[a]);
+            __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bounds[a]), vo), vi);
+            __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(n.bounds[a + 3]), vo), vi);
+            tNear = _mm_max_ps(tNear, _mm_min_ps(t0, t1));
+            tFar = _mm_min_ps(tFar, _mm_max_ps(t0, t1));
+        }
+        return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+#else
+        int mask = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            float tNear = 1e-4f, tFar = tMax;
+            for (int a = 0; a < 3; ++a) {
+                float t0 = (n.bounds[a][lane] - o[a]) * inv[a], t1 = (n.bounds[a + 3][lane] - o[a]) * inv[a];
+                tNear = std::max(tNear, std::min(t0, t1));
+                tFar = std::min(tFar, std::max(t0, t1));
+            }
+            if (tNear <= tFar) mask |= 1 << lane;
+        }
+        return mask;
+#endif
+    }
+
+    int32_t buildNode(std::vector<TracePrimitive>& prims, size_t begin, size_t end, int depth) {
+        if (depth > kMaxDepth) throw std::runtime_error("BVH exceeds maximum depth");
+        int32_t index = int32_t(nodes.size());
+        nodes.emplace_back();
+
+        // Bagi range jadi maksimal 4 bagian: split median pada sumbu centroid terpanjang
+        ArenaScope scratch;
+        ArenaVector<std::pair<size_t, size_t>> ranges(scratch.allocator<std::pair<size_t, size_t>>());
+        ranges.reserve(4);
+        ranges.push_back({begin, end});
+        while (ranges.size() < 4) {
+            auto largest = std::max_element(ranges.begin(), ranges.end(), [](auto& a, auto& b) {
+                return a.second - a.first < b.second - b.first;
+            });
+            if (largest->second - largest->first <= kLeafSize) break;
+            auto [b, e] = *largest;
+            float lo[3] = {1e30f, 1e30f, 1e30f}, hi[3] = {-1e30f, -1e30f, -1e30f};
+            for (size_t i = b; i < e; ++i) {
+                for (int a = 0; a < 3; ++a) {
+                    lo[a] = std::min(lo[a], prims[i].center[a]);
+                    hi[a] = std::max(hi[a], prims[i].center[a]);
+                }
+            }
+            int axis = 0;
+            for (int a = 1; a < 3; ++a) if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+            size_t mid = b + (e - b) / 2;
+            std::nth_element(prims.begin() + b, prims.begin() + mid, prims.begin() + e,
+                             [axis](const TracePrimitive& x, const TracePrimitive& y) { return x.center[axis] < y.center[axis]; });
+            *largest = {b, mid};
+            ranges.push_back({mid, e});
+        }
+
+        Node node;
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int a = 0; a < 3; ++a) {
+                node.bounds[a][lane] = 1e30f;
+                node.bounds[a + 3][lane] = -1e30f;
+            }
+            node.child[lane] = -1;
+            node.count[lane] = 0;
+            if (lane >= int(ranges.size())) continue;
+
+            auto [b, e] = ranges[lane];
+            for (size_t i = b; i < e; ++i) {
+                for (int a = 0; a < 3; ++a) {
+                    node.bounds[a][lane] = std::min(node.bounds[a][lane], prims[i].center[a] - prims[i].radius);
+                    node.bounds[a + 3][lane] = std::max(node.bounds[a + 3][lane], prims[i].center[a] + prims[i].radius);
+                }
+            }
+            if (e - b <= kLeafSize) {
+                node.child[lane] = ~int32_t(b);
+                node.count[lane] = uint32_t(e - b);
+            } else {
+                node.child[lane] = buildNode(prims, b, e, depth + 1);
+            }
+        }
+        nodes[index] = node;
+        return index;
+    }
+};
+
+struct TraceCamera {
+    Engine::Math::Vector3 position{0.0, 5.0, 0.0};
+    Engine::Math::Vector3 target{0.0, 5.0, -10.0};
+    double fovY = 60.0;
+};
+
+// Proxy sphere dari entity yang punya Transform + Mesh (entity legacy dan ECS). Hanya membaca scene, jadi
+// bisa dijalankan di thread simulasi dan hasilnya dirender di thread lain.
+class RenderExtractor {
+private:
+    ArchetypeWorld::Query proxyQuery = ArchetypeWorld::query<const TransformComponent, const MeshComponent>();
+
+public:
+    // alpha: posisi di antara dua step simulasi terakhir (hanya jika scene mengaktifkan render interpolation).
+    // `out` (std::vector atau ArenaVector) dikosongkan dulu; kapasitasnya dipakai ulang.
+    template <typename Out>
+    void extract(SceneManager& scene, double alpha, Out& out) {
+        out.clear();
+        auto addProxy = [&](const Engine::Math::Vector3& position, const MeshComponent& mesh, size_t seed) {
+            TracePrimitive p;
+            p.center[0] = float(position.x);
+            p.center[1] = float(position.y);
+            p.center[2] = float(position.z);
+            p.radius = float(mesh.boundsRadius);
+            double tint = double(seed % 7) / 7.0;
+            p.albedo = Engine::Math::Vector3(0.5 + 0.3 * tint, 0.5, 0.8 - 0.3 * tint);
+            out.push_back(p);
+        };
+
+        for (const auto& entity : scene.getEntities()) {
+            const auto* transform = entity->getComponent<TransformComponent>();
+            const auto* mesh = entity->getComponent<MeshComponent>();
+            if (transform && mesh) addProxy(transform->position, *mesh, entity->getId());
+        }
+        const TransformInterpolator* interpolation = scene.getInterpolation();
+        scene.getWorld().eachEntity<const TransformComponent, const MeshComponent>(proxyQuery, [&](EntityHandle h, const TransformComponent& t, const MeshComponent& m) {
+            addProxy(interpolation ? interpolation->sample(h, t, alpha).position : t.position, m, out.size());
+        });
+    }
+};
+
+class PathTracer {
+private:
+    WorkerPool& pool;
+    std::vector<TracePrimitive> primitives; // urutan BVH (di-reorder oleh build)
+    std::vector<TracePrimitive> input;      // urutan dari pemanggil, untuk deteksi perubahan
+    Bvh4 bvh;
+    std::vector<float> accR, accG, accB;
+    int width = 0, height = 0;
+    uint32_t sampleCount = 0;
+    std::atomic<uint64_t> rayCount{0};
+    RenderExtractor extractor;
+
+    static constexpr int kTileSize = 16;
+    static constexpr int kMaxDepth = 6;
+
+    // xorshift kecil per pixel; di-seed dari (pixel, sample) supaya hasil tidak tergantung jadwal thread
+    struct TraceRng {
+        uint32_t state;
+        TraceRng(uint32_t pixel, uint32_t sample) : state((pixel * 9781u + sample * 6271u) ^ 0x9E3779B9u) {
+            for (int i = 0; i < 2; ++i) next();
+        }
+        uint32_t next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+        double uniform() { return (next() >> 8) * (1.0 / 16777216.0); }
+    };
+
+    static Engine::Math::Vector3 sky(const Engine::Math::Vector3& dir) {
+        double t = 0.5 * (dir.y + 1.0);
+        return Engine::Math::Vector3(1.0, 1.0, 1.0) * (1.0 - t) + Engine::Math::Vector3(0.5, 0.7, 1.0) * t;
+    }
+
+    static Engine::Math::Vector3 cosineSample(const Engine::Math::Vector3& n, TraceRng& rng) {
+        double u1 = rng.uniform(), u2 = rng.uniform();
+        double r = std::sqrt(u1), phi = 2.0 * 3.14159265358979 * u2;
+        Engine::Math::Vector3 helper = std::abs(n.x) > 0.9 ? Engine::Math::Vector3(0, 1, 0) : Engine::Math::Vector3(1, 0, 0);
+        Engine::Math::Vector3 t = helper.cross(n).normalize();
+        Engine::Math::Vector3 b = n.cross(t);
+        return (t * (r * std::cos(phi)) + b * (r * std::sin(phi)) + n * std::sqrt(std::max(0.0, 1.0 - u1))).normalize();
+    }
+
+    Engine::Math::Vector3 radiance(Engine::Math::Vector3 origin, Engine::Math::Vector3 dir, TraceRng& rng, uint64_t& rays) const {
+        Engine::Math::Vector3 result, throughput(1.0, 1.0, 1.0);
+        for (int depth = 0; depth < kMaxDepth; ++depth) {
+            ++rays;
+            float t = 1e30f;
+            uint32_t prim = 0;
+            if (!bvh.intersect(origin, dir, t, prim)) {
+                result = result + throughput.hadamard(sky(dir));
+                break;
+            }
+            const TracePrimitive& s = primitives[prim];
+            Engine::Math::Vector3 hit = origin + dir * t;
+            Engine::Math::Vector3 normal = (hit - Engine::Math::Vector3(s.center[0], s.center[1], s.center[2])).normalize();
+            if (normal.dot(dir) > 0) normal = normal * -1.0;
+
+            result = result + throughput.hadamard(s.emission);
+            throughput = throughput.hadamard(s.albedo);
+
+            // Russian roulette setelah beberapa bounce
+            if (depth >= 2) {
+                double q = std::max({throughput.x, throughput.y, throughput.z});
+                if (rng.uniform() > q) break;
+                throughput = throughput * (1.0 / q);
+            }
+            origin = hit + normal * 1e-3;
+            dir = cosineSample(normal, rng);
+        }
+        return result;
+    }
+
+public:
+    TraceCamera camera;
+
+    explicit PathTracer(WorkerPool& p = WorkerPool::getInstance()) : pool(p) {}
+
+    // Akumulasi di-reset hanya jika proxy scene berubah
+    void setScene(SceneManager& scene, double alpha = 1.0) {
+        std::vector<TracePrimitive> extracted;
+        extractor.extract(scene, alpha, extracted);
+        setPrimitives(extracted);
+    }
+
+    static bool samePrimitive(const TracePrimitive& a, const TracePrimitive& b) {
+        return a.center[0] == b.center[0] && a.center[1] == b.center[1] && a.center[2] == b.center[2] && a.radius == b.radius &&
+               a.albedo.x == b.albedo.x && a.albedo.y == b.albedo.y && a.albedo.z == b.albedo.z &&
+               a.emission.x == b.emission.x && a.emission.y == b.emission.y && a.emission.z == b.emission.z;
+    }
+
+    // Disalin (kapasitas dipakai ulang) hanya jika berbeda dari primitive sebelumnya, dibandingkan per elemen
+    // sesuai urutan pemanggil (termasuk albedo/emission)
+    template <typename Range>
+    void setPrimitives(const Range& prims) {
+        if (!input.empty() && std::equal(prims.begin(), prims.end(), input.begin(), input.end(), samePrimitive)) return;
+        input.assign(prims.begin(), prims.end());
+        primitives.assign(prims.begin(), prims.end());
+        bvh.build(primitives);
+        resetAccumulation();
+    }
+
+    void resetAccumulation() {
+        std::fill(accR.begin(), accR.end(), 0.0f);
+        std::fill(accG.begin(), accG.end(), 0.0f);
+        std::fill(accB.begin(), accB.end(), 0.0f);
+        sampleCount = 0;
+    }
+
+    uint32_t samples() const { return sampleCount; }
+    uint64_t raysTraced() const { return rayCount.load(); }
+
+    // Tambah satu sample per pixel ke buffer akumulasi lalu tulis rata-ratanya ke framebuffer HDR
+    void accumulate(Framebuffer& out) {
+        if (out.width != width || out.height != height) {
+            width = out.width;
+            height = out.height;
+            accR.assign(out.pixelCount(), 0.0f);
+            accG.assign(out.pixelCount(), 0.0f);
+            accB.assign(out.pixelCount(), 0.0f);
+            sampleCount = 0;
+        }
+
+        using Engine::Math::Vector3;
+        Vector3 forward = (camera.target - camera.position).normalize();
+        Vector3 right = forward.cross(Vector3(0, 1, 0)).normalize();
+        Vector3 up = right.cross(forward);
+        double tanHalf = std::tan(camera.fovY * 3.14159265358979 / 360.0);
+        double aspect = double(width) / std::max(1, height);
+
+        const int tilesX = (width + kTileSize - 1) / kTileSize;
+        const int tilesY = (height + kTileSize - 1) / kTileSize;
+        const uint32_t sample = sampleCount;
+        const float weight = 1.0f / float(sample + 1);
+
+        pool.parallelFor(size_t(tilesX) * tilesY, 1, [&](size_t begin, size_t end) {
+            uint64_t rays = 0;
+            for (size_t tile = begin; tile < end; ++tile) {
+                int x0 = int(tile % tilesX) * kTileSize, y0 = int(tile / tilesX) * kTileSize;
+                for (int y = y0; y < std::min(height, y0 + kTileSize); ++y) {
+                    for (int x = x0; x < std::min(width, x0 + kTileSize); ++x) {
+                        size_t i = size_t(y) * width + x;
+                        TraceRng rng(uint32_t(i), sample);
+                        double sx = (2.0 * (x + rng.uniform()) / width - 1.0) * tanHalf * aspect;
+                        double sy = (1.0 - 2.0 * (y + rng.uniform()) / height) * tanHalf;
+                        Vector3 dir = (forward + right * sx + up * sy).normalize();
+                        Vector3 c = radiance(camera.position, dir, rng, rays);
+
+                        accR[i] += float(c.x);
+                        accG[i] += float(c.y);
+                        accB[i] += float(c.z);
+                        out.r[i] = accR[i] * weight;
+                        out.g[i] = accG[i] * weight;
+                        out.b[i] = accB[i] * weight;
+                    }
+                }
+            }
+            rayCount += rays;
+        });
+        ++sampleCount;
+    }
+};
+
+// =================================================================
+// 21. RENDER ENGINE MAIN LOOP
+// =================================================================
+
+enum class RenderMode { Rasterized, PathTraced };
+
+// Semua yang dibutuhkan render untuk satu frame; render tidak pernah menyentuh SceneManager/world.
+// Isinya dialokasikan dari arena frame-nya, jadi mengisi snapshot tidak memanggil heap.
+struct RenderSnapshot {
+    uint64_t frame = 0;
+    double alpha = 1.0;
+    ArenaVector<TracePrimitive> primitives;
+
+    void begin(uint64_t index, LinearArena& arena) {
+        frame = index;
+        alpha = 1.0;
+        primitives = ArenaVector<TracePrimitive>(ArenaAllocator<TracePrimitive>(arena));
+    }
+};
+
+// simulate(frame, snapshot) menjalankan input + update lalu mengisi snapshot; render(snapshot) hanya membacanya.
+// Mode pipelined: simulate frame N+1 berjalan di thread simulasi selagi thread pemanggil merender frame N,
+// lewat dua slot snapshot bergantian (double buffer). Thread simulasi menunggu jika kedua slot masih dipakai,
+// sehingga paling banyak satu frame di depan render. Karena itu arena frame cukup di-buffer sebanyak slot:
+// saat frame N dimulai, snapshot N-2 (pemilik arena yang di-reset) pasti sudah selesai dirender.
+// Snapshot diikat ke arena thread simulasi; job yang mengisinya harus jadi satu-satunya penulis saat itu.
+class FramePipeline {
+public:
+    static constexpr size_t kSlots = 2;
+
+private:
+    FrameArena arena{kSlots}; // dideklarasikan sebelum slot: snapshot menunjuk ke dalamnya
+    std::array<RenderSnapshot, kSlots> slots;
+    std::mutex mtx;
+    std::condition_variable cv;
+    uint64_t written = 0;  // snapshot yang sudah dipublikasikan
+    uint64_t consumed = 0; // snapshot yang selesai dirender
+    bool closed = false;
+
+    RenderSnapshot* beginWrite() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] { return closed || written - consumed < slots.size(); });
+        return closed ? nullptr : &slots[written % slots.size()];
+    }
+
+    void publish() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++written;
+        }
+        cv.notify_all();
+    }
+
+    const RenderSnapshot* acquire() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] { return closed || consumed < written; });
+        return consumed < written ? &slots[consumed % slots.size()] : nullptr;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++consumed;
+        }
+        cv.notify_all();
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+
+public:
+    template <typename Simulate, typename Render>
+    void run(int frames, bool pipelined, Simulate&& simulate, Render&& render) {
+        if (!pipelined) {
+            for (int frame = 0; frame < frames; ++frame) {
+                arena.beginFrame();
+                slots[0].begin(uint64_t(frame), arena.local());
+                simulate(frame, slots[0]);
+                render(static_cast<const RenderSnapshot&>(slots[0]));
+            }
+            return;
+        }
+
+        written = consumed = 0;
+        closed = false;
+        std::exception_ptr failure;
+        std::thread simulation([&] {
+            try {
+                for (int frame = 0; frame < frames; ++frame) {
+                    if (frame == 0) ENGINE_PROFILE_THREAD("Simulation");
+                    RenderSnapshot* slot = beginWrite();
+                    if (!slot) break; // render gagal, pipeline ditutup
+                    arena.beginFrame();
+                    slot->begin(uint64_t(frame), arena.local());
+                    simulate(frame, *slot);
+                    publish();
+                }
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            close();
+        });
+        // Jika render melempar, pipeline ditutup dulu supaya thread simulasi tidak menunggu selamanya
+        try {
+            while (const RenderSnapshot* snapshot = acquire()) {
+                render(*snapshot);
+                release();
+            }
+        } catch (...) {
+            close();
+            simulation.join();
+            throw;
+        }
+        simulation.join();
+        if (failure) std::rethrow_exception(failure);
+    }
+};
+
+// Fase frame yang diukur oleh RenderEngine::runHeadless
+enum class EnginePhase : size_t { Input, Update, Extract, Render, Count };
+constexpr size_t kEnginePhaseCount = size_t(EnginePhase::Count);
+constexpr const char* kEnginePhaseNames[kEnginePhaseCount] = {"processInput", "update", "extract", "render"};
+
+struct CrashEvent {
+    int roll;
+};
+
+struct HeadlessRunSettings {
+    int warmupFrames = 30;
+    int frames = 300;
+};
+
+// Semua dalam milidetik, satu entry per frame terukur (warm-up dibuang). frameMs = jarak antar frame selesai
+// dirender, jadi di mode pipelined nilainya mendekati max(simulasi, render), bukan jumlahnya.
+struct HeadlessRunReport {
+    std::vector<double> frameMs;
+    std::array<std::vector<double>, kEnginePhaseCount> phaseMs;
+    double wallMs = 0;
+};
+
+class RenderEngine {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool isRunning;
+    SceneManager scene;
+    PhongShader currentShader;
+    Framebuffer frame{640, 360};
+    PostProcessChain postProcess;
+    std::vector<uint32_t> presented;
+    RenderMode renderMode = RenderMode::Rasterized;
+    PathTracer pathTracer;
+    FramePacer pacer;
+    RenderExtractor extractor;
+    FramePipeline pipeline;
+    FiberScheduler jobs;
+    bool pipelined = false;
+    bool headless = false;
+    std::string profilePath;
+    std::string snapshotPath;
+    std::vector<std::array<double, kEnginePhaseCount>> phaseLog; // kosong = tidak mengukur
+    std::vector<Clock::time_point> renderDone;
+
+    static constexpr uint32_t kCrashRollStream = 1;
+
+    template <typename Fn>
+    void timed(EnginePhase phase, uint64_t frameIndex, Fn&& fn) {
+        if (frameIndex >= phaseLog.size()) {
+            fn();
+            return;
+        }
+        const auto t0 = Clock::now();
+        fn();
+        phaseLog[frameIndex][size_t(phase)] = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // Input, step update, lalu ekstraksi proxy ke snapshot. paced: step & alpha dari FramePacer (60 Hz, 60 FPS);
+    // tanpa pacing (headless) tepat satu step 1/60 s per frame dan tidak ada tunggu.
+    void simulateFrame(int frameIndex, RenderSnapshot& snapshot, bool paced) {
+        const uint64_t index = uint64_t(frameIndex);
+        if (paced && frameIndex > 0) {
+            ENGINE_PROFILE_ZONE("Pacing Wait");
+            pacer.endFrame(); // tunggu di awal frame, supaya snapshot langsung dipublikasikan
+        }
+        ENGINE_PROFILE_FRAME(frameIndex);
+        timed(EnginePhase::Input, index, [&] { processInput(); });
+        const int steps = paced ? pacer.beginFrame() : 1;
+        const double stepSeconds = paced ? pacer.stepSeconds() : 1.0 / 60.0;
+        snapshot.alpha = paced ? pacer.alpha() : 1.0;
+
+        // Graf job frame: ekstraksi proxy menunggu simulasi di dalam job-nya sendiri (fiber diparkir,
+        // worker tidak terblokir)
+        JobCounter simulated, extracted;
+        jobs.run([&] {
+            timed(EnginePhase::Update, index, [&] {
+                for (int s = 0; s < steps; ++s) update(stepSeconds);
+            });
+        }, simulated);
+        jobs.run([&] {
+            jobs.waitFor(simulated);
+            ENGINE_PROFILE_ZONE("Extract");
+            timed(EnginePhase::Extract, index, [&] { extractor.extract(scene, snapshot.alpha, snapshot.primitives); });
+        }, extracted);
+        jobs.waitFor(extracted);
+        ENGINE_PROFILE_COUNTER("Simulation Steps", steps);
+        ENGINE_PROFILE_COUNTER("Render Primitives", snapshot.primitives.size());
+    }
+
+    void renderFrame(const RenderSnapshot& snapshot) {
+        if (!headless) std::cout << "\n--- Processing Frame: " << snapshot.frame << " ---" << std::endl;
+        timed(EnginePhase::Render, snapshot.frame, [&] { render(snapshot); });
+        if (snapshot.frame < renderDone.size()) renderDone[snapshot.frame] = Clock::now();
+    }
+
+public:
+    RenderEngine() : isRunning(false) {}
+
+    void setRenderMode(RenderMode mode) { renderMode = mode; }
+
+    // Update frame N+1 berjalan di thread simulasi selagi frame N dirender
+    void setPipelined(bool enabled) { pipelined = enabled; }
+
+    // Rekam zone/counter selama start() lalu tulis trace Chrome/Perfetto ke `path`
+    void setProfileOutput(std::string path) {
+#if !ENGINE_PROFILING
+        if (!path.empty()) throw std::runtime_error("Profiling was compiled out (ENGINE_PROFILING=0); rebuild without -DENGINE_PROFILING=0 to use --profile");
+#endif
+        profilePath = std::move(path);
+    }
+
+    // Scene awal dari snapshot world (opt-in); snapshot dari build lain diabaikan dan scene dibangun manual
+    void setSnapshotPath(std::string path) { snapshotPath = std::move(path); }
+
+    // Tanpa output per frame (untuk benchmark)
+    void setHeadless(bool enabled) { headless = enabled; }
+
+    // Scene diisi pemanggil sebelum runHeadless (initialize() tidak dipanggil)
+    SceneManager& getScene() { return scene; }
+
+    void initialize() {
+        std::cout << "--- Initializing Procedural Render Engine ---" << std::endl;
+        isRunning = true;
+
+        // Setup Scene: snapshot jika diminta dan cocok dengan build ini, selain itu dibangun manual
+        bool loaded = false;
+        if (!snapshotPath.empty()) {
+            try {
+                scene.loadWorld(snapshotPath);
+                loaded = true;
+            } catch (const SnapshotMismatch& e) {
+                std::cout << "[Scene] Ignoring snapshot (" << e.what() << "), building default scene" << std::endl;
+            }
+        }
+        if (!loaded) {
+            scene.spawn(TransformComponent(0.0, 5.0, -10.0), MeshComponent("assets/hero.obj"));
+        }
+
+        scene.setRenderInterpolation(true);
+
+        scene.getEventQueue().subscribe<CrashEvent>([](const CrashEvent&){
+            std::cout << "!!! ALERT: Engine detected a collision event !!!" << std::endl;
+        });
+    }
+
+    void processInput() {
+        ENGINE_PROFILE_ZONE("processInput");
+        // Simulasi input async
+    }
+
+    void update(double deltaTime) {
+        ENGINE_PROFILE_ZONE("update");
+        scene.update(deltaTime);
+        
+        // Simulasi logika kompleks; handler jalan di update scene berikutnya. Bukan std::rand(): global,
+        // di-lock di sebagian libc, dan urutannya tergantung thread mana yang memanggil lebih dulu
+        const int roll = int(scene.random(kCrashRollStream).uniform() * 100.0f);
+        if (roll > 95) {
+            scene.getEventQueue().publish(CrashEvent{roll});
+        }
+    }
+
+    void render(const RenderSnapshot& snapshot) {
+        ENGINE_PROFILE_ZONE("render");
+        if (renderMode == RenderMode::PathTraced) {
+            {
+                ENGINE_PROFILE_ZONE("PathTracer::setPrimitives");
+                pathTracer.setPrimitives(snapshot.primitives);
+            }
+            {
+                ENGINE_PROFILE_ZONE("PathTracer::accumulate");
+                pathTracer.accumulate(frame);
+            }
+            {
+                ENGINE_PROFILE_ZONE("PostProcess");
+                postProcess.apply(frame, presented);
+            }
+            if (!headless) std::cout << "[Render] Path traced sample " << pathTracer.samples() << "... Frame Rendered." << std::endl;
+            return;
+        }
+
+        if (!headless) currentShader.execute(); // hanya mencetak log; belum ada pekerjaan shading nyata
+        {
+            ENGINE_PROFILE_ZONE("PostProcess");
+            postProcess.apply(frame, presented);
+        }
+        if (!headless) std::cout << "[Render] Flushing buffers to GPU... Frame Rendered." << std::endl;
+    }
+
+    // Simulasi 60 Hz dengan step tetap, frame dipacing ke 60 FPS. Pacer dan scene hanya disentuh oleh
+    // thread simulasi; render cukup membaca snapshot hasil ekstraksi.
+    void start() {
+        ENGINE_PROFILE_THREAD(pipelined ? "Render" : "Main");
+        if (!profilePath.empty()) Profiler::getInstance().start();
+        initialize();
+
+        pipeline.run(10, pipelined,
+            [&](int frameIndex, RenderSnapshot& snapshot) { simulateFrame(frameIndex, snapshot, true); },
+            [&](const RenderSnapshot& snapshot) { renderFrame(snapshot); });
+
+        const FramePacingStats stats = pacer.stats();
+        std::cout << std::fixed << std::setprecision(3) << "\n[Pacing] " << stats.frames << " frames: mean " << stats.meanFrameMs
+                  << " ms | jitter " << stats.jitterMs << " ms | p99 deviation " << stats.p99DeviationMs << " ms | missed "
+                  << stats.missedDeadlines << std::endl;
+
+        if (!profilePath.empty()) {
+            Profiler::getInstance().stop();
+            const size_t events = Profiler::getInstance().writeChromeTrace(profilePath);
+            Profiler::getInstance().clear();
+            std::cout << "[Profile] " << events << " events written to " << profilePath << std::endl;
+        }
+    }
+
+    // Loop tanpa pacing, sleep, maupun output: warm-up dulu, lalu catat waktu frame dan tiap fase
+    HeadlessRunReport runHeadless(const HeadlessRunSettings& settings) {
+        const bool wasHeadless = headless;
+        headless = true;
+        isRunning = true;
+        const size_t warmup = size_t(std::max(settings.warmupFrames, 0));
+        const size_t total = warmup + size_t(std::max(settings.frames, 0));
+        phaseLog.assign(total, {});
+        renderDone.assign(total, {});
+
+        if (!profilePath.empty()) Profiler::getInstance().start();
+        const auto start = Clock::now();
+        pipeline.run(int(total), pipelined,
+            [&](int frameIndex, RenderSnapshot& snapshot) { simulateFrame(frameIndex, snapshot, false); },
+            [&](const RenderSnapshot& snapshot) { renderFrame(snapshot); });
+        if (!profilePath.empty()) {
+            Profiler::getInstance().stop();
+            Profiler::getInstance().writeChromeTrace(profilePath);
+            Profiler::getInstance().clear();
+        }
+
+        HeadlessRunReport report;
+        for (size_t f = warmup; f < total; ++f) {
+            const Clock::time_point previous = f > 0 ? renderDone[f - 1] : start;
+            report.frameMs.push_back(std::chrono::duration<double, std::milli>(renderDone[f] - previous).count());
+            for (size_t p = 0; p < kEnginePhaseCount; ++p) report.phaseMs[p].push_back(phaseLog[f][p]);
+        }
+        if (total > warmup) {
+            const Clock::time_point measuredFrom = warmup > 0 ? renderDone[warmup - 1] : start;
+            report.wallMs = std::chrono::duration<double, std::milli>(renderDone[total - 1] - measuredFrom).count();
+        }
+        phaseLog.clear();
+        renderDone.clear();
+        headless = wasHeadless;
+        return report;
+    }
+};
+
+// =================================================================
+// 22. BENCHMARKS
+// =================================================================
+
+namespace Benchmarks {
+    // Status effect untuk benchmark churn: versi sparse vs versi table (archetype move)
+    struct StunnedSparse { static constexpr StorageKind storage = StorageKind::Sparse; float remaining; };
+    struct BurningSparse { static constexpr StorageKind storage = StorageKind::Sparse; float damage; };
+    struct StunnedTable { float remaining; };
+    struct BurningTable { float damage; };
+
+    struct Velocity { Engine::Math::Vector3 value; };
+    struct Health { double current, regen; };
+
+    template <typename Fn>
+    double averageMs(int iterations, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+    int postProcess() {
+        PostProcessChain chain;
+        std::vector<uint32_t> out;
+        const std::pair<int, int> sizes[] = {{1920, 1080}, {3840, 2160}};
+
+        std::cout << "[Bench] Post-process chain, " << WorkerPool::getInstance().threadCount() << " thread(s), "
+#if defined(__AVX2__)
+                  << "AVX2" << std::endl;
+#else
+                  << "scalar" << std::endl;
+#endif
+        for (auto [w, h] : sizes) {
+            // Gradient HDR dengan beberapa titik terang supaya bloom & FXAA punya pekerjaan nyata
+            Framebuffer hdr(w, h);
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    size_t i = size_t(y) * w + x;
+                    bool hot = ((x / 64) + (y / 64)) % 7 == 0;
+                    hdr.r[i] = float(x) / w * (hot ? 8.0f : 1.0f);
+                    hdr.g[i] = float(y) / h * (hot ? 8.0f : 1.0f);
+                    hdr.b[i] = ((x ^ y) & 32) ? 0.9f : 0.1f;
+                }
+            }
+
+            const int iterations = 20;
+            chain.apply(hdr, out); // warm-up
+            PostProcessTimings sum;
+            for (int i = 0; i < iterations; ++i) {
+                PostProcessTimings t = chain.apply(hdr, out);
+                sum.bloomExtractMs += t.bloomExtractMs;
+                sum.bloomBlurMs += t.bloomBlurMs;
+                sum.tonemapMs += t.tonemapMs;
+                sum.fxaaMs += t.fxaaMs;
+            }
+            std::cout << std::fixed << std::setprecision(3)
+                      << w << "x" << h << ": bloom-extract " << sum.bloomExtractMs / iterations
+                      << " ms | bloom-blur " << sum.bloomBlurMs / iterations
+                      << " ms | tonemap+gamma " << sum.tonemapMs / iterations
+                      << " ms | fxaa+pack " << sum.fxaaMs / iterations
+                      << " ms | total " << sum.totalMs() / iterations << " ms" << std::endl;
+        }
+        return 0;
+    }
+
+    int pathTrace() {
+        // Grid sphere di atas "lantai" sphere raksasa, cukup padat supaya BVH benar-benar dipakai
+        SceneManager scene;
+        auto ground = scene.createEntity();
+        ground->addComponent<TransformComponent>(0.0, -1000.0, -30.0);
+        ground->addComponent<MeshComponent>("assets/ground.obj", 1000.0);
+        for (int z = 0; z < 100; ++z) {
+            for (int x = 0; x < 100; ++x) {
+                auto e = scene.createEntity();
+                e->addComponent<TransformComponent>(-25.0 + x * 0.5, 0.2 + 0.1 * ((x * 7 + z * 3) % 5), -3.0 - z * 0.5);
+                e->addComponent<MeshComponent>("assets/mob.obj", 0.2);
+            }
+        }
+
+        PathTracer tracer;
+        tracer.camera.position = Engine::Math::Vector3(0.0, 3.0, 4.0);
+        tracer.camera.target = Engine::Math::Vector3(0.0, 0.0, -15.0);
+        tracer.setScene(scene);
+
+        Framebuffer frame(640, 360);
+        tracer.accumulate(frame); // warm-up
+        const int samples = 8;
+        uint64_t raysBefore = tracer.raysTraced();
+        double ms = averageMs(samples, [&] { tracer.accumulate(frame); });
+        double seconds = ms * samples / 1000.0;
+        double raysPerSec = double(tracer.raysTraced() - raysBefore) / seconds;
+        size_t cores = WorkerPool::getInstance().threadCount();
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "[Bench] Path tracer 640x360, " << scene.getEntities().size() << " primitives, " << cores << " thread(s)\n"
+                  << "  " << ms << " ms/spp | " << raysPerSec / 1e6 << " Mrays/s | "
+                  << raysPerSec / 1e6 / cores << " Mrays/s/core" << std::endl;
+        return 0;
+    }
+
+    int ecsUpdate() {
+        const size_t count = 1000000;
+        const int frames = 20;
+        std::cout << "[Bench] SceneManager::update, " << count << " entities (Transform + Mesh)" << std::endl;
+
+        double legacyMs;
+        {
+            SceneManager scene;
+            for (size_t i = 0; i < count; ++i) {
+                auto e = scene.createEntity();
+                e->addComponent<TransformComponent>(double(i), 0.0, 0.0);
+                e->addComponent<MeshComponent>("assets/mob.obj");
+            }
+            scene.update(0.016);
+            legacyMs = averageMs(frames, [&] { scene.update(0.016); });
+        }
+
+        double archetypeMs;
+        {
+            SceneManager scene;
+            for (size_t i = 0; i < count; ++i) {
+                scene.spawn(TransformComponent(double(i), 0.0, 0.0), MeshComponent("assets/mob.obj"));
+            }
+            scene.update(0.016);
+            archetypeMs = averageMs(frames, [&] { scene.update(0.016); });
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "  per-entity components: " << legacyMs << " ms/frame\n"
+                  << "  archetype columns:     " << archetypeMs << " ms/frame (" << legacyMs / archetypeMs << "x)" << std::endl;
+        return 0;
+    }
+
+    template <typename Stunned, typename Burning>
+    std::pair<double, double> runChurn(size_t count, int frames, size_t togglesPerFrame) {
+        ArchetypeWorld world;
+        std::vector<EntityHandle> ids;
+        for (size_t i = 0; i < count; ++i) ids.push_back(world.createEntity(TransformComponent(double(i), 0.0, 0.0)));
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        double churnMs = 0, viewMs = 0;
+        float sink = 0;
+        for (int f = 0; f < frames; ++f) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t t = 0; t < togglesPerFrame; ++t) {
+                EntityHandle a = ids[pick(rng)], b = ids[pick(rng)];
+                if (world.hasComponent<Stunned>(a)) world.removeComponent<Stunned>(a);
+                else world.addComponent<Stunned>(a, Stunned{1.0f});
+                if (world.hasComponent<Burning>(b)) world.removeComponent<Burning>(b);
+                else world.addComponent<Burning>(b, Burning{2.0f});
+            }
+            auto mid = std::chrono::steady_clock::now();
+            if constexpr (isSparseComponent<Stunned>) {
+                world.view<Stunned, Burning>([&](EntityHandle, Stunned& s, Burning& b) { sink += s.remaining * b.damage; });
+            } else {
+                world.each<Stunned, Burning>([&](Stunned& s, Burning& b) { sink += s.remaining * b.damage; });
+            }
+            auto end = std::chrono::steady_clock::now();
+            churnMs += std::chrono::duration<double, std::milli>(mid - start).count();
+            viewMs += std::chrono::duration<double, std::milli>(end - mid).count();
+        }
+        if (sink < 0) std::cout << sink;
+        double opsPerFrame = 2.0 * togglesPerFrame;
+        return {churnMs * 1e6 / (opsPerFrame * frames), viewMs / frames};
+    }
+
+    int componentChurn() {
+        const size_t count = 100000, toggles = 10000;
+        const int frames = 100;
+        std::cout << "[Bench] Component churn, " << count << " entities, " << 2 * toggles << " add/remove per frame" << std::endl;
+        auto table = runChurn<StunnedTable, BurningTable>(count, frames, toggles);
+        auto sparse = runChurn<StunnedSparse, BurningSparse>(count, frames, toggles);
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  archetype move: " << table.first << " ns/op | Stunned+Burning query " << table.second << " ms\n"
+                  << "  sparse set:     " << sparse.first << " ns/op | Stunned+Burning view  " << sparse.second << " ms" << std::endl;
+        return 0;
+    }
+
+    int spawnChurn() {
+        // Meniru MobTimer: setiap frame spawn mob baru, mob lama di-queue_free setelah lifetime habis
+        const int frames = 20000, spawnsPerFrame = 50, lifetime = 120;
+        SceneManager scene;
+        std::deque<std::pair<EntityHandle, int>> live;
+        std::vector<EntityHandle> graveyard;
+        size_t staleHits = 0;
+
+        std::cout << "[Bench] Spawn/despawn churn, " << spawnsPerFrame << " mobs/frame, lifetime " << lifetime << " frames" << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 1; f <= frames; ++f) {
+            while (!live.empty() && live.front().second <= f) {
+                scene.despawn(live.front().first);
+                if (graveyard.size() < 1024) graveyard.push_back(live.front().first);
+                live.pop_front();
+            }
+            for (int i = 0; i < spawnsPerFrame; ++i) {
+                EntityHandle mob = scene.spawn(TransformComponent(i, 0.0, 0.0), MeshComponent("assets/mob.obj"));
+                live.push_back({mob, f + lifetime});
+            }
+            scene.update(0.016);
+            if (f == 1000 || f == 5000 || f == frames) {
+                const auto& world = scene.getWorld();
+                std::cout << "  frame " << std::setw(5) << f << ": alive " << world.entityCount()
+                          << " | slots " << world.getRegistry().capacity() << " | chunks " << world.chunkCount() << std::endl;
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        for (auto h : graveyard) staleHits += scene.getWorld().isAlive(h) ? 1 : 0;
+
+        std::cout << std::fixed << std::setprecision(3) << "  " << ms / frames << " ms/frame incl. update | stale handles reported alive: "
+                  << staleHits << " / " << graveyard.size() << std::endl;
+        return 0;
+    }
+
+    int scheduler() {
+        const size_t count = 1000000;
+        const int frames = 20;
+        ArchetypeWorld world;
+        for (size_t i = 0; i < count; ++i) {
+            world.createEntity(TransformComponent(double(i), 0.0, 0.0), Velocity{{1.0, 0.5, 0.0}}, Health{100.0, 0.1});
+        }
+
+        std::vector<size_t> threadCounts{1, 2, 4};
+        size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+        if (hw > 4) threadCounts.push_back(hw);
+
+        std::cout << "[Bench] System scheduler, " << count << " entities, 4 systems (hardware threads: " << hw << ")" << std::endl;
+        double baseline = 0;
+        for (size_t threads : threadCounts) {
+            WorkerPool pool(threads);
+            SystemScheduler sched(pool);
+            sched.addEachSystem<TransformComponent, const Velocity>("Movement", [](double dt, TransformComponent& t, const Velocity& v) {
+                t.position = t.position + v.value * dt;
+            });
+            sched.addEachSystem<Velocity>("Drag", [](double, Velocity& v) { v.value = v.value * 0.999; });
+            sched.addEachSystem<Health>("Regen", [](double dt, Health& h) { h.current = std::min(100.0, h.current + h.regen * dt); });
+            sched.addEachSystem<TransformComponent>("Transform", [](double dt, TransformComponent& t) { t.update(dt); });
+
+            sched.run(world, 0.016);
+            double ms = averageMs(frames, [&] { sched.run(world, 0.016); });
+            if (threads == 1) baseline = ms;
+            std::cout << std::fixed << std::setprecision(3) << "  " << threads << " thread(s): " << ms << " ms/frame ("
+                      << baseline / ms << "x)" << std::endl;
+        }
+        return 0;
+    }
+
+    // Data turunan Mesh (mis. budget LOD) dihitung ulang tiap frame: full each vs hanya yang berubah
+    struct MeshLod {
+        int triangleBudget;
+    };
+
+    int changeDetection() {
+        const size_t count = 1000000;
+        const int frames = 20;
+        WorkerPool pool(1);
+        std::cout << "[Bench] Change detection, " << count << " entities (Mesh + MeshLod), Mesh edits per frame" << std::endl;
+
+        for (double fraction : {0.0, 0.001, 0.01, 0.1, 1.0}) {
+            ArchetypeWorld world;
+            std::vector<EntityHandle> handles;
+            for (size_t i = 0; i < count; ++i) {
+                handles.push_back(world.createEntity(MeshComponent("assets/mob.obj", 1.0 + double(i % 5)), MeshLod{0}));
+            }
+            auto lod = [](double, const MeshComponent& m, MeshLod& l) { l.triangleBudget = int(m.vertexCount * m.boundsRadius) / 3; };
+            SystemScheduler full(pool), changed(pool);
+            full.addEachSystem<const MeshComponent, MeshLod>("Lod", lod);
+            changed.addChangedSystem<const MeshComponent, MeshLod>("Lod", lod);
+            changed.run(world, 0.016); // kunjungan pertama: semua entity baru dianggap berubah
+
+            const size_t edits = size_t(double(count) * fraction);
+            std::mt19937 rng(7);
+            auto mutate = [&] {
+                for (size_t e = 0; e < edits; ++e) world.getComponent<MeshComponent>(handles[rng() % count])->vertexCount += 1;
+            };
+            auto systemMs = [&](SystemScheduler& sched) {
+                double total = 0;
+                for (int f = 0; f < frames; ++f) {
+                    mutate();
+                    total += averageMs(1, [&] { sched.run(world, 0.016); });
+                }
+                return total / frames;
+            };
+            double fullMs = systemMs(full);
+            double changedMs = systemMs(changed);
+            std::cout << std::fixed << std::setprecision(3) << "  " << std::setw(6) << fraction * 100.0 << "% changed: each "
+                      << fullMs << " ms | eachChanged " << changedMs << " ms (" << fullMs / changedMs << "x)" << std::endl;
+        }
+        return 0;
+    }
+
+    // Tag kosong untuk membuat banyak archetype: entity ke-i memakai kombinasi tag dari bit i
+    template <int N>
+    struct QueryTag {
+        int value;
+    };
+
+    template <int... Ns>
+    EntityHandle spawnTagged(ArchetypeWorld& world, size_t bits, std::integer_sequence<int, Ns...>) {
+        EntityHandle h = world.createEntity(TransformComponent(double(bits), 0.0, 0.0));
+        ((bits & (size_t(1) << Ns) ? (void)world.addComponent<QueryTag<Ns>>(h, QueryTag<Ns>{Ns}) : (void)0), ...);
+        return h;
+    }
+
+    template <typename... Ts>
+    void compareQuery(ArchetypeWorld& world, const char* label, int frames) {
+        size_t sink = 0;
+        auto body = [&](const Ts&...) { ++sink; };
+        auto query = ArchetypeWorld::query<Ts...>();
+        world.each<Ts...>(query, body);
+        double scanMs = 0, cachedMs = 0;
+        for (int round = 0; round < 4; ++round) { // diselang-seling supaya efek cache CPU tidak berat sebelah
+            scanMs += averageMs(frames, [&] { world.each<Ts...>(body); });
+            cachedMs += averageMs(frames, [&] { world.each<Ts...>(query, body); });
+        }
+        std::cout << std::fixed << std::setprecision(3) << "  " << label << " (" << query.archetypeCount() << " archetypes): scan "
+                  << scanMs * 250.0 << " us | cached " << cachedMs * 250.0 << " us (" << scanMs / cachedMs << "x)" << std::endl;
+        if (sink == 0) std::cout << sink;
+    }
+
+    int queryCache() {
+        const size_t kinds = 1024; // 10 tag -> 1024 archetype
+        const int frames = 500;
+        auto tags = std::make_integer_sequence<int, 10>{};
+        ArchetypeWorld world;
+        std::vector<EntityHandle> handles;
+        for (size_t i = 0; i < 2 * kinds; ++i) handles.push_back(spawnTagged(world, i % kinds, tags));
+
+        std::cout << "[Bench] Cached queries, " << world.archetypeCount() << " archetypes, " << world.entityCount() << " entities" << std::endl;
+        compareQuery<const TransformComponent, const QueryTag<3>>(world, "broad  <Transform, Tag3>     ", frames);
+        compareQuery<const QueryTag<0>, const QueryTag<1>, const QueryTag<2>, const QueryTag<4>, const QueryTag<5>,
+                     const QueryTag<6>, const QueryTag<7>, const QueryTag<8>>(world, "narrow <Tag0..Tag8 minus Tag3>", frames);
+
+        // Perubahan struktur tidak meng-invalidate cache: hasil harus tetap sama dengan scan penuh
+        auto query = ArchetypeWorld::query<const TransformComponent, const QueryTag<3>>();
+        world.each<const TransformComponent, const QueryTag<3>>(query, [](const TransformComponent&, const QueryTag<3>&) {});
+        std::mt19937 rng(5);
+        for (int i = 0; i < 5000; ++i) {
+            EntityHandle& h = handles[rng() % handles.size()];
+            if (rng() % 2) {
+                world.destroyEntity(h);
+                h = spawnTagged(world, rng() % kinds, tags);
+            } else if (world.hasComponent<QueryTag<3>>(h)) {
+                world.removeComponent<QueryTag<3>>(h);
+            } else {
+                world.addComponent<QueryTag<3>>(h, QueryTag<3>{3});
+            }
+        }
+        size_t scanned = 0, cached = 0;
+        world.each<const TransformComponent, const QueryTag<3>>([&](const TransformComponent&, const QueryTag<3>&) { ++scanned; });
+        world.each<const TransformComponent, const QueryTag<3>>(query, [&](const TransformComponent&, const QueryTag<3>&) { ++cached; });
+        std::cout << "  after 5000 structural changes: " << cached << " / " << scanned << " matched"
+                  << (cached == scanned ? "" : " MISMATCH") << std::endl;
+        return cached == scanned ? 0 : 1;
+    }
+
+    // Hierarki lebar (root -> 1000 -> 100 per node) dan dalam (100 rantai x 1000 level)
+    int hierarchy() {
+        using Engine::Math::Matrix4x4;
+        WorkerPool& pool = WorkerPool::getInstance();
+        std::cout << "[Bench] Transform hierarchy propagation, " << pool.threadCount() << " thread(s)" << std::endl;
+        constexpr double kMaxError = 1e-4; // urutan perkalian sama dengan referensi, jadi normalnya 0
+        bool withinTolerance = true;
+
+        struct Shape {
+            const char* name;
+            size_t roots, fanout, depth;
+        };
+        const Shape shapes[] = {{"wide 1x1000x100", 1, 0, 0}, {"deep 100x1000  ", 100, 1, 1000}};
+        for (const Shape& shape : shapes) {
+            ArchetypeWorld world;
+            TransformHierarchy tree(pool);
+            std::vector<EntityHandle> all, roots;
+            auto spawn = [&](EntityHandle parent, size_t i) {
+                EntityHandle h = world.createEntity(TransformComponent(0.5, 0.25 * double(i % 4), 0.0));
+                world.getComponent<TransformComponent>(h)->rotation = Engine::Math::Vector3(0.0, 0.01 * double(i % 13), 0.02);
+                tree.setParent(h, parent);
+                all.push_back(h);
+                return h;
+            };
+            if (shape.depth == 0) {
+                EntityHandle root = spawn({}, 0);
+                roots.push_back(root);
+                for (size_t a = 0; a < 1000; ++a) {
+                    EntityHandle mid = spawn(root, a);
+                    for (size_t b = 0; b < 100; ++b) spawn(mid, b);
+                }
+            } else {
+                for (size_t r = 0; r < shape.roots; ++r) {
+                    EntityHandle node = spawn({}, r);
+                    roots.push_back(node);
+                    for (size_t d = 1; d < shape.depth; ++d) node = spawn(node, d);
+                }
+            }
+            tree.propagate(world);
+
+            std::mt19937 rng(11);
+            size_t touched = 0;
+            auto run = [&](const char* label, int frames, const std::function<void()>& dirty) {
+                double ms = 0;
+                for (int f = 0; f < frames; ++f) {
+                    dirty();
+                    ms += averageMs(1, [&] { touched = tree.propagate(world); });
+                }
+                std::cout << std::fixed << std::setprecision(3) << "  " << shape.name << " | " << label << ": " << ms / frames
+                          << " ms, " << touched << " / " << tree.size() << " nodes recomputed" << std::endl;
+            };
+            run("clean   ", 20, [] {});
+            run("1 dirty ", 20, [&] { world.getComponent<TransformComponent>(all[rng() % all.size()])->position.x += 0.1; });
+            run("1% dirty", 10, [&] {
+                for (size_t k = 0; k < all.size() / 100; ++k) world.getComponent<TransformComponent>(all[rng() % all.size()])->position.y += 0.1;
+            });
+            run("all     ", 5, [&] { world.each<TransformComponent>([](TransformComponent& t) { t.position.z += 0.01; }); });
+
+            // Referensi: hitung ulang semua node rekursif dari root, bandingkan dengan hasil propagate
+            double maxError = 0;
+            std::vector<EntityHandle> order;
+            for (EntityHandle root : roots) tree.collectSubtree(root, order);
+            std::unordered_map<uint64_t, Matrix4x4> reference;
+            for (EntityHandle h : order) {
+                const auto* t = world.getComponent<const TransformComponent>(h);
+                Matrix4x4 local = Matrix4x4::TRS(t->position, t->rotation);
+                EntityHandle parent = tree.parentOf(h);
+                reference[h.bits()] = parent.isNull() ? local : reference[parent.bits()] * local;
+                const Matrix4x4& got = *tree.worldMatrix(h);
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 4; ++j) maxError = std::max(maxError, std::abs(got.m[i][j] - reference[h.bits()].m[i][j]));
+                }
+            }
+            withinTolerance = withinTolerance && maxError <= kMaxError;
+            std::cout << "  " << shape.name << " | depth " << tree.depth() << ", max error vs recursive reference " << maxError
+                      << (maxError <= kMaxError ? "" : " MISMATCH") << std::endl;
+        }
+        return withinTolerance ? 0 : 1;
+    }
+
+    int snapshot() {
+        const std::string path = (std::filesystem::temp_directory_path() / "nlfts_bench.snapshot").string();
+        std::cout << "[Bench] World snapshot save/load (" << path << ")" << std::endl;
+
+        struct Scene {
+            const char* name;
+            size_t entities;
+            bool withMesh;
+        };
+        bool allIdentical = true;
+        for (const Scene& scene : {Scene{"Transform+Velocity+Health", 1000000, false}, Scene{"Transform+Mesh (slow path)", 100000, true}}) {
+            auto build = [&](ArchetypeWorld& world) {
+                for (size_t i = 0; i < scene.entities; ++i) {
+                    if (scene.withMesh) {
+                        world.createEntity(TransformComponent(double(i), 0.0, 0.0), MeshComponent("assets/mob_" + std::to_string(i % 64) + ".obj"));
+                    } else {
+                        world.createEntity(TransformComponent(double(i), 0.0, 0.0), Velocity{{1.0, 0.5, 0.0}}, Health{100.0, 0.1});
+                    }
+                }
+            };
+            ArchetypeWorld original;
+            double buildMs = averageMs(1, [&] { build(original); });
+            double saveMs = averageMs(1, [&] { WorldSnapshot::save(original, path); });
+
+            ArchetypeWorld loaded;
+            double loadMs = averageMs(1, [&] { WorldSnapshot::load(loaded, path); });
+            // Iterasi pertama setelah mmap membayar page fault; diukur terpisah supaya jujur
+            double sumLoaded = 0, sumOriginal = 0;
+            double touchMs = averageMs(1, [&] {
+                loaded.each<const TransformComponent>([&](const TransformComponent& t) { sumLoaded += t.position.x; });
+            });
+            original.each<const TransformComponent>([&](const TransformComponent& t) { sumOriginal += t.position.x; });
+            loaded.each<TransformComponent>([](TransformComponent& t) { t.update(0.016); }); // virtual call pada objek hasil placement-new
+            const bool identical = sumLoaded == sumOriginal && loaded.entityCount() == original.entityCount();
+            allIdentical = allIdentical && identical;
+
+            std::cout << std::fixed << std::setprecision(3) << "  " << scene.name << ", " << scene.entities << " entities, "
+                      << std::filesystem::file_size(path) / (1024 * 1024) << " MiB: build " << buildMs << " ms | save " << saveMs
+                      << " ms | load " << loadMs << " ms | first full pass " << touchMs << " ms | "
+                      << (identical ? "identical" : "MISMATCH") << std::endl;
+        }
+        std::filesystem::remove(path);
+        return allIdentical ? 0 : 1;
+    }
+
+    // Checksum state world untuk verifikasi restore: posisi, health, path mesh, dan jumlah entity
+    double worldChecksum(ArchetypeWorld& world) {
+        double sum = double(world.entityCount());
+        world.each<const TransformComponent>([&](const TransformComponent& t) { sum += t.position.x + 0.5 * t.position.y; });
+        world.each<const Health>([&](const Health& h) { sum += h.current; });
+        world.each<const MeshComponent>([&](const MeshComponent& m) { sum += double(m.modelPath.size()); });
+        return sum;
+    }
+
+    int rollback() {
+        constexpr size_t kRing = 60;
+        constexpr int kFrames = 240;
+        std::cout << "[Bench] Rollback history, ring of " << kRing << " frames, " << kFrames << " simulated frames" << std::endl;
+
+        struct Scene {
+            const char* name;
+            size_t movers;
+            size_t statics;
+        };
+        bool allIdentical = true;
+        for (const Scene& scene : {Scene{"10k movers + 90k static", 10000, 90000}, Scene{"100k movers", 100000, 0}}) {
+            ArchetypeWorld world;
+            for (size_t i = 0; i < scene.movers; ++i) {
+                world.createEntity(TransformComponent(double(i), 0.0, 0.0), Velocity{{1.0, 0.5, 0.0}}, Health{100.0, 0.1});
+            }
+            for (size_t i = 0; i < scene.statics; ++i) world.createEntity(TransformComponent(double(i), 1.0, 0.0), Health{50.0, 0.0});
+            std::deque<EntityHandle> projectiles; // spawn/despawn tiap frame: perubahan struktur + kolom non-relocatable
+
+            WorldHistory history(kRing);
+            std::deque<double> expected;
+            double captureMs = 0;
+            for (int frame = 0; frame < kFrames; ++frame) {
+                world.each<TransformComponent, const Velocity>([](TransformComponent& t, const Velocity& v) {
+                    t.position = t.position + v.value * 0.016;
+                });
+                for (int k = 0; k < 16; ++k) {
+                    projectiles.push_back(world.createEntity(TransformComponent(double(frame), double(k), 0.0),
+                                                             MeshComponent("assets/bolt_" + std::to_string(frame % 7) + ".obj")));
+                }
+                while (projectiles.size() > 256) {
+                    world.destroyEntity(projectiles.front());
+                    projectiles.pop_front();
+                }
+                captureMs += averageMs(1, [&] { history.capture(world); });
+                expected.push_back(worldChecksum(world));
+                if (expected.size() > kRing) expected.pop_front();
+            }
+
+            bool identical = true;
+            double worstRestoreMs = 0;
+            for (size_t back : {size_t(0), kRing / 2, kRing - 1}) {
+                worstRestoreMs = std::max(worstRestoreMs, averageMs(1, [&] { history.restore(world, back); }));
+                identical &= worldChecksum(world) == expected[expected.size() - 1 - back];
+            }
+            // Resimulasi dari frame yang dipulihkan tetap bisa di-capture dan di-restore
+            history.restore(world, kRing - 1);
+            world.each<TransformComponent, const Velocity>([](TransformComponent& t, const Velocity& v) { t.position = t.position + v.value; });
+            history.capture(world);
+            const double resimulated = worldChecksum(world);
+            history.restore(world, 1);
+            identical &= worldChecksum(world) == expected.back();
+            history.restore(world, 0);
+            identical &= worldChecksum(world) == resimulated;
+            allIdentical = allIdentical && identical;
+
+            std::cout << std::fixed << std::setprecision(3) << "  " << scene.name << ": capture " << captureMs / kFrames
+                      << " ms/frame | ring " << history.memoryBytes() / (1024 * 1024) << " MiB | worst restore " << worstRestoreMs
+                      << " ms | " << (identical ? "identical" : "MISMATCH") << std::endl;
+        }
+        return allIdentical ? 0 : 1;
+    }
+
+    // Loop lama (dt tetap 16 ms + sleep tetap) dibandingkan FramePacer dengan beban frame 2-8 ms yang bervariasi
+    int framePacing() {
+        constexpr int kFrames = 180;
+        std::cout << "[Bench] Frame pacing, 60 Hz simulation, 60 FPS target, " << kFrames << " frames, 2-8 ms of work per frame" << std::endl;
+        auto busy = [](double ms) {
+            const auto until = FramePacer::Clock::now() + std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+            while (FramePacer::Clock::now() < until) cpuRelax();
+        };
+        auto report = [](const char* name, double wallMs, double simulatedMs, double meanMs, double jitterMs, double p99Ms) {
+            std::cout << std::fixed << std::setprecision(3) << "  " << std::left << std::setw(18) << name << std::right << " mean frame " << meanMs
+                      << " ms | jitter " << jitterMs << " ms | p99 deviation " << p99Ms << " ms | sim-vs-real drift "
+                      << simulatedMs - wallMs << " ms" << std::endl;
+        };
+
+        {
+            std::mt19937 rng(1);
+            std::uniform_real_distribution<double> work(2.0, 8.0);
+            std::vector<double> intervals;
+            double simulatedMs = 0;
+            const auto start = FramePacer::Clock::now();
+            auto last = start;
+            for (int frame = 0; frame < kFrames; ++frame) {
+                simulatedMs += 16.0;
+                busy(work(rng));
+                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+                const auto now = FramePacer::Clock::now();
+                intervals.push_back(std::chrono::duration<double, std::milli>(now - last).count());
+                last = now;
+            }
+            const double wallMs = std::chrono::duration<double, std::milli>(last - start).count();
+            double mean = 0, sq = 0, worst = 0;
+            for (double ms : intervals) {
+                mean += ms / kFrames;
+                sq += ms * ms / kFrames;
+            }
+            std::vector<double> deviation;
+            for (double ms : intervals) deviation.push_back(std::abs(ms - 1000.0 / 60.0));
+            std::sort(deviation.begin(), deviation.end());
+            worst = deviation[size_t(0.99 * (deviation.size() - 1))];
+            report("fixed dt + sleep", wallMs, simulatedMs, mean, std::sqrt(std::max(0.0, sq - mean * mean)), worst);
+        }
+        {
+            std::mt19937 rng(1);
+            std::uniform_real_distribution<double> work(2.0, 8.0);
+            FramePacer pacer;
+            double simulatedMs = 0;
+            int steps = 0;
+            const auto start = FramePacer::Clock::now();
+            for (int frame = 0; frame < kFrames; ++frame) {
+                const int n = pacer.beginFrame();
+                steps += n;
+                simulatedMs += n * pacer.stepSeconds() * 1000.0;
+                busy(work(rng));
+                pacer.endFrame();
+            }
+            // Dibandingkan di awal frame terakhir: state simulasi + sisa accumulator = waktu nyata
+            const double wallMs = std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - start).count();
+            const FramePacingStats stats = pacer.stats();
+            report("FramePacer", wallMs, simulatedMs + pacer.alpha() * pacer.stepSeconds() * 1000.0, stats.meanFrameMs, stats.jitterMs, stats.p99DeviationMs);
+            std::cout << std::fixed << std::setprecision(3) << "    " << steps << " steps | wake error " << stats.meanWakeErrorMs
+                      << " ms | missed " << stats.missedDeadlines << " | dropped " << stats.droppedSimMs << " ms" << std::endl;
+        }
+        return 0;
+    }
+
+    // Throughput serial (update + render) vs pipelined (mendekati max(update, render)). Kasus kedua mensimulasikan
+    // render yang menunggu GPU (sleep), sehingga overlap terlihat walau mesin hanya punya satu core.
+    int framePipeline() {
+        constexpr int kFrames = 40;
+        std::cout << "[Bench] Pipelined update/render, " << kFrames << " frames, " << WorkerPool::getInstance().threadCount()
+                  << " pool thread(s)" << std::endl;
+
+        for (bool gpuBound : {false, true}) {
+            SceneManager scene;
+            scene.setRenderInterpolation(true);
+            for (int z = 0; z < 60; ++z) {
+                for (int x = 0; x < 60; ++x) {
+                    scene.spawn(TransformComponent(-15.0 + x * 0.5, 0.2, -3.0 - z * 0.5), MeshComponent("assets/mob.obj", 0.2), Velocity{{0.0, 0.0, 0.0}});
+                }
+            }
+            // Beban gameplay sintetis: gerak melingkar dengan sedikit matematika per entity
+            scene.getScheduler().addEachSystem<TransformComponent, Velocity>("Orbit", [](double dt, TransformComponent& t, Velocity& v) {
+                double phase = t.position.x * 0.37 + t.position.z * 0.11;
+                for (int k = 0; k < 24; ++k) phase = std::sin(phase + dt) * 1.0001 + std::cos(phase * 0.5);
+                v.value = Engine::Math::Vector3(std::cos(phase), 0.0, std::sin(phase)) * 0.5;
+                t.position = t.position + v.value * dt;
+            });
+
+            PathTracer tracer;
+            tracer.camera.position = Engine::Math::Vector3(0.0, 3.0, 4.0);
+            tracer.camera.target = Engine::Math::Vector3(0.0, 0.0, -15.0);
+            Framebuffer frame(160, 90);
+            RenderExtractor extractor;
+            FramePipeline pipeline;
+            auto simulate = [&](int, RenderSnapshot& snapshot) {
+                scene.update(1.0 / 60.0);
+                extractor.extract(scene, 1.0, snapshot.primitives);
+            };
+            auto render = [&](const RenderSnapshot& snapshot) {
+                if (gpuBound) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(8)); // CPU menunggu fence GPU
+                } else {
+                    tracer.setPrimitives(snapshot.primitives);
+                    tracer.accumulate(frame);
+                }
+            };
+
+            LinearArena probeArena;
+            RenderSnapshot probe;
+            probe.begin(0, probeArena);
+            double updateMs = averageMs(kFrames / 4, [&] { simulate(0, probe); });
+            double renderMs = averageMs(kFrames / 4, [&] { render(probe); });
+            double serialMs = averageMs(1, [&] { pipeline.run(kFrames, false, simulate, render); }) / kFrames;
+            double pipelinedMs = averageMs(1, [&] { pipeline.run(kFrames, true, simulate, render); }) / kFrames;
+
+            std::cout << std::fixed << std::setprecision(3) << "  " << (gpuBound ? "render waits on GPU (8 ms)" : "CPU path tracer 160x90   ")
+                      << ": update " << updateMs << " ms | render " << renderMs << " ms | serial " << serialMs << " ms/frame | pipelined "
+                      << pipelinedMs << " ms/frame (max " << std::max(updateMs, renderMs) << ", sum " << updateMs + renderMs << ")" << std::endl;
+        }
+        return 0;
+    }
+
+    // Fork-join tree (tiap node menunggu anaknya) di WorkerPool (tunggu sambil membantu di stack yang sama)
+    // vs FiberScheduler (node yang menunggu diparkir sebagai fiber)
+    int fiberJobs() {
+        size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+        const size_t threads = std::max<size_t>(hw, 4);
+        constexpr int kFanout = 8, kDepth = 4, kRounds = 20;
+        WorkerPool pool(threads);
+        FiberScheduler fibers(threads);
+        std::cout << "[Bench] Fork-join job tree, fan-out " << kFanout << ", depth " << kDepth << ", " << threads << " thread(s), "
+                  << hw << " hardware thread(s)" << std::endl;
+
+        auto leafWork = [](size_t seed) {
+            double x = double(seed);
+            for (int k = 0; k < 200; ++k) x = std::sin(x) + 1.0;
+            return x;
+        };
+
+        for (bool withWork : {false, true}) {
+            std::atomic<size_t> nodes{0}, sink{0};
+            std::atomic<int> maxNesting{0};
+            thread_local int nesting = 0;
+
+            std::function<void(int)> poolNode = [&](int depth) {
+                ++nesting;
+                maxNesting.store(std::max(maxNesting.load(), nesting));
+                nodes.fetch_add(1);
+                if (withWork) sink.fetch_add(size_t(leafWork(nodes.load())));
+                if (depth > 0) {
+                    std::atomic<int> pending{kFanout};
+                    for (int i = 0; i < kFanout; ++i) pool.submit([&, depth] { poolNode(depth - 1); pending.fetch_sub(1); }, &pending);
+                    pool.waitUntil(&pending, [&] { return pending.load() == 0; });
+                }
+                --nesting;
+            };
+            std::function<void(int)> fiberNode = [&](int depth) {
+                nodes.fetch_add(1);
+                if (withWork) sink.fetch_add(size_t(leafWork(nodes.load())));
+                if (depth > 0) {
+                    JobCounter children;
+                    for (int i = 0; i < kFanout; ++i) fibers.run([&, depth] { fiberNode(depth - 1); }, children);
+                    fibers.waitFor(children);
+                }
+            };
+
+            nodes = 0;
+            double poolMs = averageMs(kRounds, [&] { poolNode(kDepth); });
+            const size_t poolNodes = nodes.load() / kRounds;
+            nodes = 0;
+            double fiberMs = averageMs(kRounds, [&] {
+                JobCounter root;
+                fibers.run([&] { fiberNode(kDepth); }, root);
+                fibers.waitFor(root);
+            });
+            const size_t fiberNodes = nodes.load() / kRounds;
+
+            std::cout << std::fixed << std::setprecision(3) << "  " << (withWork ? "200 sin/node" : "empty nodes ") << ": WorkerPool "
+                      << poolMs << " ms (" << poolNodes << " nodes, help-while-wait nesting up to " << maxNesting.load()
+                      << ") | fibers " << fiberMs << " ms (" << fiberNodes << " nodes, " << fibers.fiberCount() << " fibers, "
+                      << 1e6 * fiberMs / double(fiberNodes) << " ns/job)" << std::endl;
+        }
+        return 0;
+    }
+
+    // Data transien per frame (daftar event, visible set, command buffer): std::vector di heap vs ArenaVector di
+    // FrameArena yang di-reset tiap frame. Ukuran acak supaya vector tumbuh seperti pemakaian nyata (tanpa reserve).
+    int frameArena() {
+        constexpr int kFrames = 200, kLists = 2000;
+        std::cout << "[Bench] Transient per-frame containers, " << kLists << " lists of 16-256 elements per frame, "
+                  << kFrames << " frames" << std::endl;
+        std::vector<uint32_t> sizes(kLists);
+        std::mt19937 rng(7);
+        for (auto& n : sizes) n = 16 + rng() % 241;
+
+        auto fill = [&](auto& list, size_t n) {
+            for (size_t i = 0; i < n; ++i) list.push_back(uint64_t(i) * 2654435761u);
+            return list.back();
+        };
+
+        uint64_t sink = 0;
+        double heapMs = averageMs(kFrames, [&] {
+            std::vector<std::vector<uint64_t>> lists;
+            for (uint32_t n : sizes) {
+                lists.emplace_back();
+                sink += fill(lists.back(), n);
+            }
+        });
+
+        FrameArena arena(2);
+        double arenaMs = averageMs(kFrames, [&] {
+            arena.beginFrame();
+            LinearArena& local = arena.local();
+            ArenaVector<ArenaVector<uint64_t>> lists{ArenaAllocator<ArenaVector<uint64_t>>(local)};
+            for (uint32_t n : sizes) {
+                lists.emplace_back(ArenaAllocator<uint64_t>(local));
+                sink += fill(lists.back(), n);
+            }
+        });
+
+        std::cout << std::fixed << std::setprecision(3) << "  std::vector (heap): " << heapMs << " ms/frame | ArenaVector (frame arena): "
+                  << arenaMs << " ms/frame | speedup " << heapMs / arenaMs << "x | arena " << arena.capacity() / 1024
+                  << " KiB reserved for " << arena.bufferedFrames() << " frames (checksum " << (sink & 0xFF) << ")" << std::endl;
+        return 0;
+    }
+
+    // Biaya marker: zone saat tidak merekam (cek atomic saja) dan saat merekam (2x baca clock + 1 event),
+    // dibandingkan loop yang sama tanpa marker
+    int profiler() {
+        constexpr int kZones = 1000000;
+        Profiler& profiler = Profiler::getInstance();
+        std::cout << "[Bench] Profiler markers, " << kZones << " zones per run, ENGINE_PROFILING=" << ENGINE_PROFILING << std::endl;
+
+        volatile uint64_t sink = 0;
+        auto work = [&](int i) { sink = sink + uint64_t(i); };
+        auto plain = [&] {
+            for (int i = 0; i < kZones; ++i) work(i);
+        };
+        auto zoned = [&] {
+            for (int i = 0; i < kZones; ++i) {
+                ENGINE_PROFILE_ZONE("Bench Zone");
+                work(i);
+            }
+        };
+        auto counted = [&] {
+            for (int i = 0; i < kZones; ++i) {
+                ENGINE_PROFILE_COUNTER("Bench Counter", i);
+                work(i);
+            }
+        };
+
+        const double baseNs = averageMs(5, plain) * 1e6 / kZones;
+        // Selisih terhadap loop polos bisa negatif karena noise (marker mati nyaris gratis); dijepit ke 0
+        const double idleNs = std::max(0.0, averageMs(5, zoned) * 1e6 / kZones - baseNs);
+        profiler.start();
+        const double zoneNs = std::max(0.0, averageMs(2, zoned) * 1e6 / kZones - baseNs);
+        const double counterNs = std::max(0.0, averageMs(2, counted) * 1e6 / kZones - baseNs);
+        profiler.stop();
+        const size_t recorded = profiler.eventCount();
+
+        const std::string path = "bench_profile.trace.json";
+        auto t0 = std::chrono::steady_clock::now();
+        const size_t written = profiler.writeChromeTrace(path);
+        const double exportMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::filesystem::remove(path);
+        profiler.clear();
+
+        std::cout << std::fixed << std::setprecision(2) << "  zone, not recording: " << idleNs << " ns | zone, recording: " << zoneNs
+                  << " ns | counter, recording: " << counterNs << " ns | " << recorded << " events recorded" << std::endl;
+        std::cout << "  export: " << written << " events in " << exportMs << " ms" << std::endl;
+        return 0;
+    }
+
+    // triggerEvent lama (std::map<std::string, std::function>, satu callback) vs EventDispatcher dengan id
+    // compile-time; 64 event terdaftar supaya pohon map punya kedalaman realistis
+    int eventDispatch() {
+        constexpr int kTriggers = 2000000;
+        constexpr int kEvents = 64;
+        std::cout << "[Bench] Event dispatch, " << kEvents << " registered events, " << kTriggers << " triggers" << std::endl;
+
+        std::vector<std::string> names;
+        for (int i = 0; i < kEvents; ++i) names.push_back("Gameplay/Event" + std::to_string(i));
+        names[kEvents / 2] = "OnCrash";
+
+        volatile uint64_t sink = 0;
+        std::map<std::string, std::function<void()>> legacy;
+        for (const std::string& name : names) legacy[name] = [&sink] { sink = sink + 1; };
+        auto legacyTrigger = [&](const std::string& name) {
+            if (legacy.count(name)) legacy[name]();
+        };
+        const double legacyNs = averageMs(kTriggers, [&] { legacyTrigger("OnCrash"); }) * 1e6;
+
+        std::cout << std::fixed << std::setprecision(2) << "  map<string, function>, 1 callback: " << legacyNs << " ns/trigger" << std::endl;
+        for (int subscribers : {1, 4}) {
+            EventDispatcher dispatcher;
+            for (const std::string& name : names) {
+                for (int k = 0; k < subscribers; ++k) dispatcher.subscribe(EventId::of(name), [&sink] { sink = sink + 1; });
+            }
+            const double ns = averageMs(kTriggers, [&] { dispatcher.trigger("OnCrash"_event); }) * 1e6;
+            const double runtimeNs = averageMs(kTriggers, [&] { dispatcher.trigger(EventId::of(names[kEvents / 2])); }) * 1e6;
+            std::cout << "  EventDispatcher, " << subscribers << " subscriber(s): " << ns << " ns/trigger (runtime string id: "
+                      << runtimeNs << " ns)" << std::endl;
+        }
+        return 0;
+    }
+
+    // Publish dari satu thread lalu dispatch per "frame"; lalu 4 thread produsen mem-publish terus-menerus
+    // sementara thread utama men-dispatch (pertukaran buffer bersaing dengan publish)
+    int eventQueue() {
+        struct Damage { EntityHandle target; float amount; };
+        struct Spawned { EntityHandle entity; Engine::Math::Vector3 position; };
+        constexpr int kFrames = 20;
+        constexpr int kEventsPerFrame = 100000;
+        std::cout << "[Bench] Deferred event queue, " << kEventsPerFrame << " events/frame (2 types), " << kFrames << " frames" << std::endl;
+
+        EventQueue queue;
+        double damage = 0;
+        uint64_t spawned = 0;
+        queue.subscribe<Damage>([&](const Damage& e) { damage += e.amount; });
+        queue.subscribe<Spawned>([&](const Spawned& e) { spawned += e.entity.index; });
+        auto publish = [&](int i) {
+            if (i & 1) queue.publish(Damage{EntityHandle{uint32_t(i), 0}, 1.0f});
+            else queue.publish(Spawned{EntityHandle{uint32_t(i), 0}, Engine::Math::Vector3(i, 0.0, 0.0)});
+        };
+        auto publishFrame = [&] {
+            for (int i = 0; i < kEventsPerFrame; ++i) publish(i);
+        };
+        publishFrame(); // warm-up: buffer mencapai kapasitas puncak
+        queue.dispatch();
+
+        double publishMs = 0, dispatchMs = 0;
+        size_t dispatched = 0;
+        for (int f = 0; f < kFrames; ++f) {
+            publishMs += averageMs(1, publishFrame);
+            dispatchMs += averageMs(1, [&] { dispatched += queue.dispatch(); });
+        }
+        const double events = double(kFrames) * kEventsPerFrame;
+        std::cout << std::fixed << std::setprecision(2) << "  1 producer: publish " << publishMs * 1e6 / events << " ns/event | dispatch "
+                  << dispatchMs * 1e6 / events << " ns/event | " << dispatched << " delivered"
+                  << (dispatched == size_t(events) ? "" : " MISMATCH") << std::endl;
+        bool allDelivered = dispatched == size_t(events);
+
+        constexpr int kProducers = 4;
+        std::atomic<int> running{kProducers};
+        dispatched = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = p; i < kFrames * kEventsPerFrame; i += kProducers) publish(i);
+                running.fetch_sub(1);
+            });
+        }
+        while (running.load() > 0) dispatched += queue.dispatch();
+        for (auto& t : producers) t.join();
+        dispatched += queue.dispatch();
+        const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "  " << kProducers << " producers + concurrent dispatch: " << totalMs * 1e6 / events << " ns/event end-to-end | "
+                  << dispatched << " delivered" << (dispatched == size_t(events) ? "" : " MISMATCH") << std::endl;
+        allDelivered = allDelivered && dispatched == size_t(events);
+        return allDelivered ? 0 : 1;
+    }
+
+    // Biaya emit per jumlah slot, dibanding daftar std::function yang dilindungi mutex; lalu emit dari
+    // beberapa thread sementara satu thread terus connect/disconnect
+    int signals() {
+        constexpr int kEmits = 1000000;
+        std::cout << "[Bench] Signal emit, " << kEmits << " emits" << std::endl;
+
+        volatile uint64_t sink = 0;
+        for (int slots : {0, 1, 100}) {
+            Signal<int> signal;
+            std::vector<ScopedConnection> connections;
+            std::mutex mtx;
+            std::vector<std::function<void(int)>> locked;
+            for (int i = 0; i < slots; ++i) {
+                connections.emplace_back(signal.connect([&sink](int v) { sink = sink + uint64_t(v); }));
+                locked.emplace_back([&sink](int v) { sink = sink + uint64_t(v); });
+            }
+            const int emits = slots >= 100 ? kEmits / 20 : kEmits;
+            const double signalNs = averageMs(emits, [&] { signal.emit(1); }) * 1e6;
+            const double lockedNs = averageMs(emits, [&] {
+                std::lock_guard<std::mutex> lock(mtx);
+                for (auto& fn : locked) fn(1);
+            }) * 1e6;
+            std::cout << std::fixed << std::setprecision(2) << "  " << std::setw(3) << slots << " slot(s): Signal " << signalNs
+                      << " ns/emit | mutex + vector<function> " << lockedNs << " ns/emit" << std::endl;
+        }
+
+        constexpr int kEmitters = 3;
+        Signal<int> signal;
+        std::atomic<uint64_t> total{0}; // slot jalan di beberapa thread sekaligus
+        ScopedConnection keep = signal.connect([&total](int v) { total.fetch_add(uint64_t(v), std::memory_order_relaxed); });
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> emitted{0};
+        std::vector<std::thread> emitters;
+        for (int t = 0; t < kEmitters; ++t) {
+            emitters.emplace_back([&] {
+                uint64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    signal.emit(1);
+                    ++n;
+                }
+                emitted += n;
+            });
+        }
+        int churn = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(200)) {
+            ScopedConnection temporary = signal.connect([&total](int v) { total.fetch_add(uint64_t(v), std::memory_order_relaxed); });
+            ++churn;
+        }
+        stop = true;
+        for (auto& t : emitters) t.join();
+        std::cout << "  " << kEmitters << " emitting threads + connect/disconnect churn: " << emitted.load() * 5 / 1000 << "k emits/s, "
+                  << churn * 5 << " connect+disconnect/s" << std::endl;
+        return 0;
+    }
+
+    // Tata letak Entity sebelum pooling (make_unique per komponen), hanya untuk pembanding
+    struct HeapEntity {
+        size_t id;
+        std::vector<std::unique_ptr<Component>> components;
+        std::vector<ComponentTypeId> componentTypes;
+
+        explicit HeapEntity(size_t _id) : id(_id) {}
+
+        template <typename T, typename... Args>
+        void addComponent(Args&&... args) {
+            components.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+            componentTypes.push_back(componentTypeId<T>());
+        }
+
+        void update(double dt) {
+            for (auto& comp : components) comp->update(dt);
+        }
+    };
+
+    // Entity::addComponent lama (make_unique per komponen) vs ComponentPool: waktu build, update loop, jarak
+    // alamat antar TransformComponent berturut-turut, dan cache miss saat update (jika perf counter tersedia)
+    int componentPool() {
+        PerfCounters counters;
+        std::cout << "[Bench] Legacy Entity components: make_unique vs ComponentPool" << std::endl;
+        if (!counters.anyAvailable()) std::cout << "  (perf counters unavailable: " << counters.unavailableReason() << ")" << std::endl;
+
+        auto medianStride = [](std::vector<uintptr_t> addresses) {
+            std::vector<uintptr_t> strides;
+            for (size_t i = 1; i < addresses.size(); ++i) {
+                strides.push_back(addresses[i] > addresses[i - 1] ? addresses[i] - addresses[i - 1] : addresses[i - 1] - addresses[i]);
+            }
+            std::nth_element(strides.begin(), strides.begin() + strides.size() / 2, strides.end());
+            return strides[strides.size() / 2];
+        };
+
+        for (size_t count : {size_t(100000), size_t(1000000)}) {
+            auto measure = [&](const char* label, auto makeEntity, auto firstComponent) {
+                using EntityPtr = decltype(makeEntity(size_t(0)));
+                std::vector<EntityPtr> entities;
+                entities.reserve(count);
+                const double buildMs = averageMs(1, [&] {
+                    for (size_t i = 0; i < count; ++i) entities.push_back(makeEntity(i));
+                });
+                std::vector<uintptr_t> addresses;
+                for (auto& e : entities) addresses.push_back(reinterpret_cast<uintptr_t>(firstComponent(*e)));
+
+                const int frames = count >= 1000000 ? 5 : 30;
+                auto frame = [&] {
+                    for (auto& e : entities) e->update(0.016);
+                };
+                frame(); // warm-up
+                counters.start();
+                const double updateMs = averageMs(frames, frame);
+                const auto misses = counters.stop();
+                const double destroyMs = averageMs(1, [&] { entities.clear(); });
+
+                std::cout << std::fixed << std::setprecision(3) << "  " << std::setw(7) << count << " " << label << ": build " << buildMs
+                          << " ms | update " << updateMs << " ms/frame | destroy " << destroyMs << " ms | Transform stride "
+                          << medianStride(addresses) << " B";
+                for (size_t c = 0; c < PerfCounters::Count; ++c) {
+                    if (counters.available(PerfCounters::Counter(c))) {
+                        std::cout << " | " << PerfCounters::kNames[c] << " " << double(misses[c]) / frames / count << "/entity";
+                    }
+                }
+                std::cout << std::endl;
+            };
+            auto build = [](auto e, size_t i) {
+                e->template addComponent<TransformComponent>(double(i), 0.0, 0.0);
+                e->template addComponent<MeshComponent>("assets/mob.obj");
+                return e;
+            };
+            measure("make_unique", [&](size_t i) { return build(std::make_shared<HeapEntity>(i), i); },
+                    [](HeapEntity& e) { return e.components[0].get(); });
+            measure("pooled     ", [&](size_t i) { return build(std::make_shared<Entity>(i), i); },
+                    [](Entity& e) { return e.getComponent<TransformComponent>(); });
+        }
+        return 0;
+    }
+
+    // Spawn satu per satu (createEntity) vs Prefab::instantiate. Gelombang pertama "cold" (world baru, halaman
+    // memori baru); gelombang berikutnya di-spawn setelah gelombang sebelumnya di-despawn, seperti gelombang mob.
+    // Varian "+ init" menulis posisi grid lewat kolom SoA.
+    int prefabSpawn() {
+        constexpr size_t kCount = 100000;
+        constexpr int kRuns = 10;
+        std::cout << "[Bench] Batch spawn, " << kCount << " entities per run" << std::endl;
+
+        bool mismatch = false;
+        auto report = [&](const char* label, auto spawn) {
+            ArchetypeWorld world;
+            std::vector<EntityHandle> handles;
+            handles.reserve(kCount);
+            double coldMs = 0, warmMs = 0;
+            for (int run = 0; run <= kRuns; ++run) {
+                handles.clear();
+                (run == 0 ? coldMs : warmMs) += averageMs(1, [&] { spawn(world, handles); });
+                if (world.entityCount() != kCount || handles.size() != kCount) {
+                    std::cout << "  MISMATCH: " << world.entityCount() << " entities" << std::endl;
+                    mismatch = true;
+                }
+                for (EntityHandle h : handles) world.destroyEntity(h);
+            }
+            std::cout << std::fixed << std::setprecision(3) << "  " << label << ": cold " << coldMs << " ms | warm "
+                      << warmMs / kRuns << " ms" << std::endl;
+        };
+
+        const Velocity velocity{{0.0, 0.0, -1.0}};
+        report("createEntity, Transform+Velocity        ", [&](ArchetypeWorld& world, std::vector<EntityHandle>& handles) {
+            for (size_t i = 0; i < kCount; ++i) handles.push_back(world.createEntity(TransformComponent(0.0, 0.0, 0.0), velocity));
+        });
+        Prefab mob(TransformComponent(0.0, 0.0, 0.0), velocity);
+        report("instantiate, Transform+Velocity         ", [&](ArchetypeWorld& world, std::vector<EntityHandle>& handles) {
+            world.instantiate(mob, kCount, handles);
+        });
+        report("instantiate + init, Transform+Velocity  ", [&](ArchetypeWorld& world, std::vector<EntityHandle>& handles) {
+            world.instantiate<TransformComponent>(mob, kCount, handles, [](size_t first, size_t n, TransformComponent* t) {
+                for (size_t i = 0; i < n; ++i) {
+                    t[i].position.x = double((first + i) % 316);
+                    t[i].position.z = double((first + i) / 316);
+                }
+            });
+        });
+        report("createEntity, Transform+Mesh+Velocity   ", [&](ArchetypeWorld& world, std::vector<EntityHandle>& handles) {
+            for (size_t i = 0; i < kCount; ++i) {
+                handles.push_back(world.createEntity(TransformComponent(0.0, 0.0, 0.0), MeshComponent("assets/mob.obj"), velocity));
+            }
+        });
+        Prefab meshMob(TransformComponent(0.0, 0.0, 0.0), MeshComponent("assets/mob.obj"), velocity);
+        report("instantiate, Transform+Mesh+Velocity    ", [&](ArchetypeWorld& world, std::vector<EntityHandle>& handles) {
+            world.instantiate(meshMob, kCount, handles);
+        });
+        return mismatch ? 1 : 0;
+    }
+
+    // std::rand / mt19937 vs Philox per nilai dan per batch, lalu 4 thread yang menarik angka per entity:
+    // std::rand global (urutan tergantung jadwal) vs CounterRng per entity (harus sama dengan hasil serial)
+    int counterRng() {
+        constexpr size_t kValues = 1 << 22;
+        std::vector<float> out(kValues);
+        volatile float sink = 0;
+        std::cout << "[Bench] Random numbers, " << kValues << " floats, "
+#if defined(__AVX2__)
+                  << "AVX2" << std::endl;
+#else
+                  << "scalar" << std::endl;
+#endif
+        auto report = [&](const char* label, auto&& fill) {
+            const double ns = averageMs(5, [&] { fill(); sink = sink + out[kValues / 2]; }) * 1e6 / kValues;
+            std::cout << std::fixed << std::setprecision(2) << "  " << label << ns << " ns/value" << std::endl;
+        };
+        report("std::rand() / RAND_MAX            ", [&] {
+            for (auto& v : out) v = float(std::rand()) / float(RAND_MAX);
+        });
+        std::mt19937 mt(42);
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+        std::normal_distribution<float> gaussian(0.0f, 1.0f);
+        report("mt19937 uniform                   ", [&] { for (auto& v : out) v = uniform(mt); });
+        report("CounterRng::uniform()             ", [&] {
+            Random::CounterRng rng(42, 0, 0, 0);
+            for (auto& v : out) v = rng.uniform();
+        });
+        report("CounterRng::fillUniform           ", [&] { Random::CounterRng(42, 0, 0, 0).fillUniform(out.data(), kValues); });
+        report("mt19937 normal_distribution       ", [&] { for (auto& v : out) v = gaussian(mt); });
+        report("CounterRng::normal()              ", [&] {
+            Random::CounterRng rng(42, 0, 0, 0);
+            for (auto& v : out) v = rng.normal();
+        });
+        report("CounterRng::fillNormal            ", [&] { Random::CounterRng(42, 0, 0, 0).fillNormal(out.data(), kValues); });
+
+        // 16 normal per entity; sama dengan pola sistem "jitter" yang dijalankan parallelFor
+        constexpr size_t kEntities = 1 << 16, kPerEntity = 16;
+        WorkerPool pool(4);
+        std::vector<float> serial(kEntities * kPerEntity), parallel(kEntities * kPerEntity), shared(kEntities * kPerEntity);
+        auto drawEntity = [&](std::vector<float>& dst, size_t e) {
+            Random::CounterRng(42, 7, EntityHandle{uint32_t(e), 0}.bits(), 100).fillNormal(&dst[e * kPerEntity], kPerEntity);
+        };
+        const double serialMs = averageMs(10, [&] { for (size_t e = 0; e < kEntities; ++e) drawEntity(serial, e); });
+        const double parallelMs = averageMs(10, [&] {
+            pool.parallelFor(kEntities, 1024, [&](size_t begin, size_t end) { for (size_t e = begin; e < end; ++e) drawEntity(parallel, e); });
+        });
+        const double sharedMs = averageMs(10, [&] {
+            pool.parallelFor(kEntities, 1024, [&](size_t begin, size_t end) {
+                for (size_t i = begin * kPerEntity; i < end * kPerEntity; ++i) shared[i] = float(std::rand()) / float(RAND_MAX);
+            });
+        });
+        std::cout << std::fixed << std::setprecision(3) << "  " << kEntities << " entities x " << kPerEntity << " normals, "
+                  << pool.threadCount() << " threads: std::rand " << sharedMs << " ms | CounterRng serial " << serialMs
+                  << " ms, parallel " << parallelMs << " ms | " << (serial == parallel ? "identical" : "MISMATCH") << std::endl;
+        return serial == parallel ? 0 : 1;
+    }
+
+    // RenderEngine penuh tanpa pacing/sleep/log; ukuran dan campuran scene lewat argumen, hasil hanya JSON di stdout:
+    //   --bench-engine [--entities N] [--moving F] [--parented F] [--legacy N] [--frames N] [--warmup N]
+    //                  [--pathtrace] [--pipelined] [--profile path]
+    int engine(int argc, char** argv) {
+        size_t entities = 10000, legacy = 1000;
+        double moving = 0.5, parented = 0.1;
+        HeadlessRunSettings settings;
+        bool pathTraced = false, pipelined = false;
+        std::string profilePath;
+        for (int i = 2; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+                return argv[++i];
+            };
+            if (arg == "--entities") entities = std::stoul(value());
+            else if (arg == "--moving") moving = std::clamp(std::stod(value()), 0.0, 1.0);
+            else if (arg == "--parented") parented = std::clamp(std::stod(value()), 0.0, 1.0);
+            else if (arg == "--legacy") legacy = std::stoul(value());
+            else if (arg == "--frames") settings.frames = std::max(1, std::stoi(value()));
+            else if (arg == "--warmup") settings.warmupFrames = std::max(0, std::stoi(value()));
+            else if (arg == "--pathtrace") pathTraced = true;
+            else if (arg == "--pipelined") pipelined = true;
+            else if (arg == "--profile") profilePath = value();
+            else throw std::runtime_error("Unknown --bench-engine option: " + arg);
+        }
+
+        RenderEngine renderEngine;
+        renderEngine.setRenderMode(pathTraced ? RenderMode::PathTraced : RenderMode::Rasterized);
+        renderEngine.setPipelined(pipelined);
+        renderEngine.setProfileOutput(profilePath);
+
+        // Grid deterministik; entity bergerak dan entity berparent disebar merata (bukan blok di depan)
+        SceneManager& scene = renderEngine.getScene();
+        scene.setRenderInterpolation(true);
+        const size_t side = std::max<size_t>(1, size_t(std::ceil(std::sqrt(double(entities)))));
+        std::vector<EntityHandle> spawned;
+        spawned.reserve(entities);
+        size_t movingCount = 0, parentedCount = 0;
+        for (size_t i = 0; i < entities; ++i) {
+            TransformComponent t(-15.0 + double(i % side) * 30.0 / side, 0.2, -3.0 - double(i / side) * 30.0 / side);
+            const bool moves = size_t(double(i + 1) * moving) > movingCount;
+            if (moves) {
+                spawned.push_back(scene.spawn(t, MeshComponent("assets/mob.obj", 0.2), Velocity{{0.0, 0.0, 0.0}}));
+                ++movingCount;
+            } else {
+                spawned.push_back(scene.spawn(t, MeshComponent("assets/mob.obj", 0.2)));
+            }
+            if (i > 0 && size_t(double(i + 1) * parented) > parentedCount) {
+                scene.setParent(spawned.back(), spawned[(i - 1) / 2]);
+                ++parentedCount;
+            }
+        }
+        scene.getScheduler().addEachSystem<TransformComponent, Velocity>("Wander", [](double dt, TransformComponent& t, Velocity& v) {
+            const double phase = t.position.x * 0.37 + t.position.z * 0.11 + t.rotation.y;
+            v.value = Engine::Math::Vector3(std::cos(phase), 0.0, std::sin(phase)) * 0.5;
+            t.position = t.position + v.value * dt;
+        });
+        for (size_t i = 0; i < legacy; ++i) {
+            auto e = scene.createEntity();
+            e->addComponent<TransformComponent>(double(i), 0.0, 0.0);
+            e->addComponent<MeshComponent>("assets/mob.obj");
+        }
+
+        const HeadlessRunReport report = renderEngine.runHeadless(settings);
+
+        auto stats = [](std::vector<double> ms) {
+            std::sort(ms.begin(), ms.end());
+            auto at = [&](double q) { return ms[size_t(q * double(ms.size() - 1))]; };
+            double sum = 0;
+            for (double v : ms) sum += v;
+            std::ostringstream json;
+            json << std::fixed << std::setprecision(4) << "{\"mean\": " << sum / ms.size() << ", \"p50\": " << at(0.5)
+                 << ", \"p95\": " << at(0.95) << ", \"p99\": " << at(0.99) << ", \"max\": " << ms.back() << "}";
+            return json.str();
+        };
+
+        std::cout << "{\n"
+                  << "  \"scene\": {\"entities\": " << entities << ", \"moving\": " << movingCount << ", \"parented\": " << parentedCount
+                  << ", \"legacy\": " << legacy << "},\n"
+                  << "  \"mode\": {\"render\": \"" << (pathTraced ? "pathtrace" : "raster") << "\", \"pipelined\": "
+                  << (pipelined ? "true" : "false") << ", \"poolThreads\": " << WorkerPool::getInstance().threadCount() << "},\n"
+                  << "  \"warmupFrames\": " << settings.warmupFrames << ",\n"
+                  << "  \"frames\": " << report.frameMs.size() << ",\n"
+                  << std::fixed << std::setprecision(2) << "  \"fps\": " << report.frameMs.size() * 1000.0 / report.wallMs << ",\n"
+                  << "  \"frameMs\": " << stats(report.frameMs) << ",\n"
+                  << "  \"phasesMs\": {\n";
+        for (size_t p = 0; p < kEnginePhaseCount; ++p) {
+            std::cout << "    \"" << kEnginePhaseNames[p] << "\": " << stats(report.phaseMs[p]) << (p + 1 < kEnginePhaseCount ? "," : "") << "\n";
+        }
+        std::cout << "  }\n}" << std::endl;
+        return 0;
+    }
+
+    int parallelUpdate() {
+        size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+        WorkerPool pool(std::max<size_t>(hw, 4));
+        std::cout << "[Bench] Parallel SceneManager::update (legacy entities), " << pool.threadCount()
+                  << " pool thread(s), " << hw << " hardware thread(s)" << std::endl;
+
+        bool allIdentical = true;
+        for (size_t count : {size_t(10000), size_t(100000), size_t(1000000)}) {
+            auto build = [&](SceneManager& scene) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto e = scene.createEntity();
+                    e->addComponent<TransformComponent>(double(i), 0.0, 0.0);
+                    e->addComponent<MeshComponent>("assets/mob.obj");
+                }
+            };
+            SceneManager serial(pool), parallel(pool);
+            build(serial);
+            build(parallel);
+            parallel.setParallelUpdate(true);
+
+            const int frames = count >= 1000000 ? 10 : 100;
+            double serialMs = averageMs(frames, [&] { serial.update(0.016); });
+            double parallelMs = averageMs(frames, [&] { parallel.update(0.016); });
+
+            bool identical = true;
+            for (size_t i = 0; i < count && identical; ++i) {
+                identical = serial.getEntities()[i]->getComponent<TransformComponent>()->position.x ==
+                            parallel.getEntities()[i]->getComponent<TransformComponent>()->position.x;
+            }
+            allIdentical = allIdentical && identical;
+            std::cout << std::fixed << std::setprecision(3) << "  " << std::setw(7) << count << " entities: serial " << serialMs
+                      << " ms | parallel " << parallelMs << " ms | speedup " << serialMs / parallelMs << "x | "
+                      << (identical ? "identical" : "MISMATCH") << std::endl;
+        }
+        return allIdentical ? 0 : 1;
+    }
+}
+
+// =================================================================
+// 23. ENTRY POINT
+// =================================================================
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "--bench-postfx") return Benchmarks::postProcess();
+    if (mode == "--bench-pathtrace") return Benchmarks::pathTrace();
+    if (mode == "--bench-ecs") return Benchmarks::ecsUpdate();
+    if (mode == "--bench-churn") return Benchmarks::componentChurn();
+    if (mode == "--bench-spawn") return Benchmarks::spawnChurn();
+    if (mode == "--bench-scheduler") return Benchmarks::scheduler();
+    if (mode == "--bench-parallel-update") return Benchmarks::parallelUpdate();
+    if (mode == "--bench-changed") return Benchmarks::changeDetection();
+    if (mode == "--bench-query") return Benchmarks::queryCache();
+    if (mode == "--bench-hierarchy") return Benchmarks::hierarchy();
+    if (mode == "--bench-snapshot") return Benchmarks::snapshot();
+    if (mode == "--bench-rollback") return Benchmarks::rollback();
+    if (mode == "--bench-pacing") return Benchmarks::framePacing();
+    if (mode == "--bench-pipeline") return Benchmarks::framePipeline();
+    if (mode == "--bench-fibers") return Benchmarks::fiberJobs();
+    if (mode == "--bench-arena") return Benchmarks::frameArena();
+    if (mode == "--bench-profiler") return Benchmarks::profiler();
+    if (mode == "--bench-events") return Benchmarks::eventDispatch();
+    if (mode == "--bench-event-queue") return Benchmarks::eventQueue();
+    if (mode == "--bench-signals") return Benchmarks::signals();
+    if (mode == "--bench-component-pool") return Benchmarks::componentPool();
+    if (mode == "--bench-prefab") return Benchmarks::prefabSpawn();
+    if (mode == "--bench-rng") return Benchmarks::counterRng();
+    if (mode == "--bench-engine") {
+        try {
+            return Benchmarks::engine(argc, argv);
+        } catch (const std::exception& e) {
+            std::cerr << "Engine Benchmark Error: " << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    try {
+        RenderEngine engine;
+        if (mode == "--pathtrace") engine.setRenderMode(RenderMode::PathTraced);
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--pipelined") engine.setPipelined(true);
+            if (arg == "--snapshot" && i + 1 < argc) engine.setSnapshotPath(argv[++i]);
+            if (arg == "--profile") {
+                // Path opsional setelah flag
+                const bool hasPath = i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0;
+                engine.setProfileOutput(hasPath ? argv[++i] : "profile.trace.json");
+            }
+        }
         engine.start();
     } catch (const std::exception& e) {
         std::cerr << "Engine Runtime Error: " << e.what() << std::endl;